@@ -6,7 +6,7 @@ namespace BattleCity {
 
 AIController::AIController()
     : currentState_(AIState::IDLE), stateTimer_(0), chaseTimer_(0),
-      moveDirection_(Direction::UP), directionChangeTimer_(0) {
+      moveDirection_(Direction::UP), directionChangeTimer_(0), headingForBase_(false) {
 }
 
 void AIController::init(EnemyType type) {
@@ -16,24 +16,28 @@ void AIController::init(EnemyType type) {
             directionChangeInterval_ = 250; // 150-300 frames
             chaseTimeout_ = 300;
             evadeDuration_ = 20;
+            baseChance_ = 25;
             break;
         case EnemyType::FAST:
             sightRange_ = 64;
             directionChangeInterval_ = 200; // 100-250 frames
             chaseTimeout_ = 250;
             evadeDuration_ = 20;
+            baseChance_ = 25;
             break;
         case EnemyType::HEAVY:
             sightRange_ = 64;
             directionChangeInterval_ = 400; // 250-500 frames
             chaseTimeout_ = 350;
             evadeDuration_ = 20;
+            baseChance_ = 50;  // Slow and armored, goes for the base
             break;
         case EnemyType::ELITE:
             sightRange_ = 96;
             directionChangeInterval_ = 250; // 180-300 frames
             chaseTimeout_ = 400;
             evadeDuration_ = 25;
+            baseChance_ = 35;
             break;
     }
 }
@@ -93,30 +97,39 @@ void AIController::updateIdle(EnemyTank& tank) {
     // Random movement with occasional direction changes
     directionChangeTimer_--;
     if (directionChangeTimer_ <= 0) {
-        // Choose random direction
+        // Head for the base or choose a random direction
         Direction dirs[4] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+        headingForBase_ = rand() % 100 < baseChance_;
         moveDirection_ = dirs[rand() % 4];
         directionChangeTimer_ = directionChangeInterval_ + (rand() % 100 - 50); // Add variance
     }
 
+    // The path to the base is cached, following it is a lookup per frame
+    bool throughBrick = false;
+    if (headingForBase_) {
+        moveDirection_ = calculateChaseDirection(tank, tank.getBasePosition(), throughBrick);
+    }
+
     tank.setDirection(moveDirection_);
     tank.move();
 
-    // Random shooting (30% chance for basic, varies by type)
+    // Random shooting (30% chance for basic, varies by type); always when
+    // brick is in the way
     int shootChance = 30; // Basic default
-    if (rand() % 100 < shootChance) {
+    if (throughBrick || rand() % 100 < shootChance) {
         tank.shoot();
     }
 }
 
 void AIController::updateChase(EnemyTank& tank) {
-    // Move towards player
-    Direction chaseDir = Direction::RIGHT; // TODO: Implement proper chase direction
+    // Follow the path to the nearest player
+    bool throughBrick = false;
+    Direction chaseDir = calculateChaseDirection(tank, tank.getPlayerPosition(), throughBrick);
     tank.setDirection(chaseDir);
     tank.move();
 
-    // Shoot at player if aligned (simplified)
-    if ((rand() % 100) < 30) { // 30% chance to shoot when chasing
+    // Shoot at player if aligned or to clear brick off the path
+    if (throughBrick || isAlignedWithPlayer(tank) || (rand() % 100) < 30) { // 30% chance otherwise
         tank.shoot();
     }
 
@@ -138,10 +151,16 @@ void AIController::updateFrozen(EnemyTank& tank) {
     // Do nothing - tank is frozen by timer bomb
 }
 
-Direction AIController::calculateChaseDirection(const EnemyTank& tank) const {
-    Vector2 playerPos = Vector2::fromPixels(120, 200); // Placeholder player position
+Direction AIController::calculateChaseDirection(const EnemyTank& tank, const Vector2& target, bool& throughBrick) const {
+    PathStep step = tank.findPathTo(target);
+    throughBrick = step.found && step.throughBrick;
+    if (step.found) {
+        return step.direction;
+    }
+
+    // Same tile as the target, or nothing leads there
     Vector2 tankPos = tank.getPosition();
-    Vector2 delta = playerPos - tankPos;
+    Vector2 delta = target - tankPos;
 
     // Prioritize horizontal alignment, then vertical
     if (abs(delta.pixelX()) > abs(delta.pixelY())) {
@@ -171,7 +190,7 @@ bool AIController::hasLineOfSight(const EnemyTank& tank, const Vector2& target)
 
 bool AIController::isAlignedWithPlayer(const EnemyTank& tank) const {
     // Simplified alignment check
-    Vector2 playerPos = Vector2::fromPixels(120, 200); // Placeholder player position
+    Vector2 playerPos = tank.getPlayerPosition();
     Vector2 tankPos = tank.getPosition();
     Direction tankDir = tank.getDirection();
 
@@ -19,6 +19,7 @@ private:
     int chaseTimer_;
     Direction moveDirection_;
     int directionChangeTimer_;
+    bool headingForBase_;  // Idle tanks sometimes follow the path to the base
     Vector2 lastPlayerPosition_;
 
     // AI parameters (vary by enemy type)
@@ -26,6 +27,7 @@ private:
     int directionChangeInterval_;
     int chaseTimeout_;
     int evadeDuration_;
+    int baseChance_;  // Percent of idle direction changes that head for the base
 
 public:
     AIController();
@@ -47,7 +49,8 @@ private:
     void updateEvade(class EnemyTank& tank);
     void updateFrozen(class EnemyTank& tank);
 
-    Direction calculateChaseDirection(const class EnemyTank& tank) const;
+    // Next step of the path to target; straight at it when there is no path
+    Direction calculateChaseDirection(const class EnemyTank& tank, const Vector2& target, bool& throughBrick) const;
     Direction getOppositeDirection(Direction dir) const;
     bool hasLineOfSight(const class EnemyTank& tank, const Vector2& target) const;
     bool isAlignedWithPlayer(const class EnemyTank& tank) const;
@@ -0,0 +1,203 @@
+#include "Pathfinder.h"
+#include "../level/LevelManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace BattleCity {
+
+namespace {
+
+uint8_t tileCost(TerrainType terrain) {
+    uint8_t flags = getTerrainFlags(terrain);
+    if (!(flags & TERRAIN_BLOCKS_TANKS)) return Pathfinder::COST_OPEN;
+    return (flags & TERRAIN_DESTRUCTIBLE) ? Pathfinder::COST_BRICK : 0;
+}
+
+uint64_t cacheKey(int start, int goal) {
+    return (static_cast<uint64_t>(start) << 32) | static_cast<uint32_t>(goal);
+}
+
+} // namespace
+
+Pathfinder::Pathfinder()
+    : width_(0), height_(0), journalSequence_(0), search_(0), searches_(0), hits_(0) {
+}
+
+void Pathfinder::sync(const LevelData& level, const TerrainJournal& journal) {
+    bool sameMap = level.terrain.getWidth() == width_ && level.terrain.getHeight() == height_;
+    if (!sameMap || !journal.readSince(journalSequence_, [this](const TerrainChange& change) {
+            applyChange(change);
+        })) {
+        rebuild(level);
+    }
+    journalSequence_ = journal.getHead();
+}
+
+void Pathfinder::rebuild(const LevelData& level) {
+    width_ = level.terrain.getWidth();
+    height_ = level.terrain.getHeight();
+    size_t tiles = static_cast<size_t>(width_) * height_;
+    costs_.resize(tiles);
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            costs_[y * width_ + x] = tileCost(level.terrain[y][x]);
+        }
+    }
+
+    scores_.assign(tiles, 0);
+    parents_.assign(tiles, -1);
+    visited_.assign(tiles, 0);
+    search_ = 0;
+    clearCache();
+}
+
+void Pathfinder::applyChange(const TerrainChange& change) {
+    int tile = change.y * width_ + change.x;
+    uint8_t cost = tileCost(change.terrain);
+    uint8_t previous = costs_[tile];
+    if (cost == previous) return;  // Chipped brick is still brick
+    costs_[tile] = cost;
+
+    if (cost != 0 && (previous == 0 || cost < previous)) {
+        clearCache();
+        return;
+    }
+    for (CachedPath& path : paths_) {
+        if (path.valid && std::find(path.cells.begin(), path.cells.end(), tile) != path.cells.end()) {
+            path.valid = false;
+        }
+    }
+}
+
+void Pathfinder::clearCache() {
+    paths_.clear();
+    cache_.clear();
+}
+
+PathStep Pathfinder::findPath(int startX, int startY, int goalX, int goalY) {
+    if (width_ == 0 || height_ == 0) return {false, Direction::UP, false, 0};
+
+    // Spawn points may lie past the terrain's edge
+    int start = std::clamp(startY, 0, height_ - 1) * width_ + std::clamp(startX, 0, width_ - 1);
+    int goal = std::clamp(goalY, 0, height_ - 1) * width_ + std::clamp(goalX, 0, width_ - 1);
+
+    auto entry = cache_.find(cacheKey(start, goal));
+    if (entry != cache_.end()) {
+        if (paths_[entry->second.path].valid) {
+            ++hits_;
+            return makeStep(paths_[entry->second.path], entry->second.index);
+        }
+        cache_.erase(entry);
+    }
+
+    if (static_cast<int>(paths_.size()) >= MAX_CACHED_PATHS) clearCache();
+    int path = search(start, goal);
+    return makeStep(paths_[path], 0);
+}
+
+int Pathfinder::search(int start, int goal) {
+    ++searches_;
+    if (++search_ == 0) {
+        // Stamps wrapped; forget all of them once
+        std::fill(visited_.begin(), visited_.end(), 0);
+        search_ = 1;
+    }
+
+    int goalX = goal % width_;
+    int goalY = goal / width_;
+    auto heuristic = [&](int tile) {
+        return static_cast<uint32_t>((std::abs(tile % width_ - goalX) + std::abs(tile / width_ - goalY)) * COST_OPEN);
+    };
+    auto queue = [&](int tile) {
+        open_.push_back((static_cast<uint64_t>(scores_[tile] + heuristic(tile)) << 32) | static_cast<uint32_t>(tile));
+        std::push_heap(open_.begin(), open_.end(), std::greater<uint64_t>());
+    };
+
+    // The start tile itself is never charged, a tank may stand anywhere
+    open_.clear();
+    visited_[start] = search_;
+    scores_[start] = 0;
+    parents_[start] = -1;
+    queue(start);
+
+    bool found = false;
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), std::greater<uint64_t>());
+        uint64_t top = open_.back();
+        open_.pop_back();
+        int tile = static_cast<int>(top & 0xFFFFFFFFu);
+        if ((top >> 32) != scores_[tile] + heuristic(tile)) continue;  // Reached more cheaply since
+        if (tile == goal) {
+            found = true;
+            break;
+        }
+
+        int x = tile % width_;
+        int y = tile / width_;
+        const int neighbours[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+        for (const auto& offset : neighbours) {
+            int nextX = x + offset[0];
+            int nextY = y + offset[1];
+            if (nextX < 0 || nextX >= width_ || nextY < 0 || nextY >= height_) continue;
+            int next = nextY * width_ + nextX;
+            if (costs_[next] == 0) continue;
+
+            uint32_t score = scores_[tile] + costs_[next];
+            if (visited_[next] == search_ && scores_[next] <= score) continue;
+            visited_[next] = search_;
+            scores_[next] = score;
+            parents_[next] = tile;
+            queue(next);
+        }
+    }
+
+    // Unreachable goals are cached too (an empty path), so tanks stuck
+    // behind steel don't search every frame
+    CachedPath path;
+    path.valid = true;
+    if (found) {
+        for (int tile = goal; tile != -1; tile = parents_[tile]) {
+            path.cells.push_back(tile);
+        }
+        std::reverse(path.cells.begin(), path.cells.end());
+        uint32_t total = scores_[goal];
+        for (int tile : path.cells) {
+            path.costs.push_back(static_cast<int>(total - scores_[tile]));
+        }
+    }
+
+    int index = static_cast<int>(paths_.size());
+    if (found) {
+        for (size_t i = 0; i < path.cells.size(); ++i) {
+            cache_[cacheKey(path.cells[i], goal)] = {index, static_cast<int>(i)};
+        }
+    } else {
+        cache_[cacheKey(start, goal)] = {index, 0};
+    }
+    paths_.push_back(std::move(path));
+    return index;
+}
+
+PathStep Pathfinder::makeStep(const CachedPath& path, int index) const {
+    PathStep step = {false, Direction::UP, false, 0};
+    if (index + 1 >= static_cast<int>(path.cells.size())) return step;
+
+    int tile = path.cells[index];
+    int next = path.cells[index + 1];
+    step.found = true;
+    if (next == tile - width_) {
+        step.direction = Direction::UP;
+    } else if (next == tile + width_) {
+        step.direction = Direction::DOWN;
+    } else if (next == tile - 1) {
+        step.direction = Direction::LEFT;
+    } else {
+        step.direction = Direction::RIGHT;
+    }
+    step.throughBrick = costs_[next] == COST_BRICK;
+    step.cost = path.costs[index];
+    return step;
+}
+
+} // namespace BattleCity
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../level/TerrainJournal.h"
+#include "../utils/MathUtils.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace BattleCity {
+
+struct LevelData;
+
+// First step of a path, for the tank asking for it
+struct PathStep {
+    bool found;           // False: the goal can't be reached (or start == goal)
+    Direction direction;  // Towards the next tile
+    bool throughBrick;    // The next tile is brick that has to be shot away
+    int cost;             // Of the rest of the path (COST_OPEN per open tile)
+};
+
+// A* over the terrain tiles for the enemy tanks. Floor and forest cost one
+// step, brick costs more (it has to be shot away first), steel and water
+// can't be crossed.
+//
+// Found paths are cached; every tile along a path is cached as a start for
+// the same goal, so a tank following a path only searches once. sync()
+// applies the terrain journal: a tile that got dearer drops the paths
+// through it, a tile that got cheaper (brick destroyed) drops them all,
+// since it may open a shortcut anywhere.
+class Pathfinder {
+public:
+    static constexpr int COST_OPEN = 10;
+    static constexpr int COST_BRICK = 40;
+    static constexpr int MAX_CACHED_PATHS = 256;  // Cache is cleared beyond this
+
+private:
+    struct CachedPath {
+        std::vector<int> cells;  // Start to goal, y * width + x
+        std::vector<int> costs;  // Cost from each cell to the goal
+        bool valid;
+    };
+    struct CacheEntry {
+        int path;   // Index into paths_
+        int index;  // Position of the start tile in the path
+    };
+
+    int width_;
+    int height_;
+    std::vector<uint8_t> costs_;  // Per tile, 0 where tanks can't go
+    uint32_t journalSequence_;
+
+    std::vector<CachedPath> paths_;
+    std::unordered_map<uint64_t, CacheEntry> cache_;
+
+    // Search state, reused between searches
+    std::vector<uint32_t> scores_;    // Cost from the start
+    std::vector<int> parents_;
+    std::vector<uint32_t> visited_;   // Search that last touched each tile
+    uint32_t search_;
+    std::vector<uint64_t> open_;      // Min-heap of (estimate << 32 | tile)
+
+    uint32_t searches_;
+    uint32_t hits_;
+
+public:
+    Pathfinder();
+
+    // Bring the tile costs up to date with the level. Rebuilds everything
+    // after a new stage, otherwise only applies the journaled changes.
+    void sync(const LevelData& level, const TerrainJournal& journal);
+
+    // Tiles; outside the map counts as the nearest edge tile
+    PathStep findPath(int startX, int startY, int goalX, int goalY);
+
+    void clearCache();
+    uint32_t getSearchCount() const { return searches_; }
+    uint32_t getCacheHits() const { return hits_; }
+
+private:
+    void rebuild(const LevelData& level);
+    void applyChange(const TerrainChange& change);
+    int search(int start, int goal);  // Index of the new path in paths_
+    PathStep makeStep(const CachedPath& path, int index) const;
+};
+
+} // namespace BattleCity
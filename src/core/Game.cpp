@@ -24,6 +24,8 @@ Game::Game()
     // Initialize level manager
     levelManager_ = std::make_unique<LevelManager>(*random_);
     
+    pendingSpawns_.reserve(MAX_ENEMIES);
+
     // Set enemy spawn callback
     levelManager_->setEnemySpawnCallback([this](EnemyType type, const Vector2& position) {
         this->spawnEnemy(type, position);
@@ -37,6 +39,20 @@ bool Game::init() {
         return false;
     }
 
+    // Load sprite art from the baked pack, or from the loose files if there is
+    // no (current) pack; entities fall back to placeholder shapes without either
+    bool spritesLoaded = assetPack_.open(std::string("assets/") + PACK_FILE_NAME) &&
+                         renderer_->loadSprites(assetPack_);
+    if (!spritesLoaded && !renderer_->loadSprites("assets/sprites")) {
+        std::cerr << "Sprites not found, using placeholder graphics" << std::endl;
+    }
+    effects_.loadSprites(renderer_->getAtlas());
+
+#ifdef BATTLECITY_SCANLINE_RENDERER
+    // NES-style output: nametable background, OAM sprites, 8 sprites per line
+    renderer_->setScanlineMode(true);
+#endif
+
     // Load high score
     loadHighScore();
     // Ensure we start at the menu (do not auto-start players/levels)
@@ -102,6 +118,7 @@ bool Game::run() {
 }
 
 void Game::shutdown() {
+    renderer_->stopCapture();
     saveHighScore();
     std::cout << "Battle City shutdown complete." << std::endl;
 }
@@ -143,6 +160,10 @@ void Game::changeState(GameState newState) {
             saveHighScore();
             break;
         case GameState::LEVEL_COMPLETE:
+            // Prepare the next stage while the tally is on screen
+            if (currentLevel_ < LevelManager::MAX_LEVELS) {
+                levelManager_->preloadLevel(currentLevel_ + 1, renderer_->getAtlas());
+            }
             break;
     }
 }
@@ -152,12 +173,13 @@ void Game::startLevel(int level) {
     levelManager_->loadLevel(level);
     cleanupLevel();
 
-    // Reset player positions
+    // Reset player positions (from the stage file)
+    const std::vector<Vector2>& spawnPoints = levelManager_->getPlayerSpawnPoints();
     if (player1_) {
-        player1_->setPosition(Vector2::fromPixels(80, 200));
+        player1_->setPosition(spawnPoints[0]);
     }
     if (player2_ && isTwoPlayerMode_) {
-        player2_->setPosition(Vector2::fromPixels(160, 200));
+        player2_->setPosition(spawnPoints.size() > 1 ? spawnPoints[1] : Vector2::fromPixels(160, 200));
     }
 }
 
@@ -183,9 +205,9 @@ void Game::shootBullet(const Vector2& position, Direction direction, BulletOwner
 }
 
 void Game::spawnEnemy(EnemyType type, const Vector2& position) {
-    // Limit maximum enemies on screen (original game: 4 max)
-    int maxEnemies = 4;
-    int activeEnemies = 0;
+    // Limit maximum enemies on screen (original game: 4 max), counting the
+    // ones still behind their spawn star
+    int activeEnemies = static_cast<int>(pendingSpawns_.size());
 
     for (auto& enemy : enemies_) {
         if (enemy && enemy->isActive()) {
@@ -193,14 +215,31 @@ void Game::spawnEnemy(EnemyType type, const Vector2& position) {
         }
     }
 
-    if (activeEnemies >= maxEnemies) {
+    if (activeEnemies >= MAX_ENEMIES) {
         return; // Can't spawn more enemies
     }
 
-    // Create new enemy
-    auto enemy = std::make_unique<EnemyTank>(type, this);
-    enemy->setPosition(position);
-    enemies_.push_back(std::move(enemy));
+    // The enemy appears when the star has finished
+    EffectHandle star = effects_.spawn(EffectType::SPAWN_STAR, position.pixelX() + 4, position.pixelY() + 4);
+    pendingSpawns_.push_back({type, position, star});
+}
+
+void Game::activatePendingSpawns() {
+    for (size_t i = 0; i < pendingSpawns_.size();) {
+        const PendingSpawn& spawn = pendingSpawns_[i];
+        if (effects_.isRunning(spawn.star)) {
+            ++i;
+            continue;
+        }
+
+        // Create new enemy
+        auto enemy = std::make_unique<EnemyTank>(spawn.type, this);
+        enemy->setPosition(spawn.position);
+        enemies_.push_back(std::move(enemy));
+
+        pendingSpawns_[i] = pendingSpawns_.back();
+        pendingSpawns_.pop_back();
+    }
 }
 
 void Game::spawnPowerUp(const Vector2& position) {
@@ -252,7 +291,7 @@ void Game::checkPowerUpCollisions() {
 
 void Game::nextLevel() {
     currentLevel_++;
-    if (currentLevel_ > 35) {
+    if (currentLevel_ > LevelManager::MAX_LEVELS) {
         // Game completed!
         changeState(GameState::MENU);
         return;
@@ -340,6 +379,9 @@ void Game::update() {
 
 void Game::render() {
     renderer_->clear();
+    if (currentState_ != GameState::PLAYING && currentState_ != GameState::PAUSED) {
+        renderer_->setCamera(0, 0);
+    }
 
     switch (currentState_) {
         case GameState::MENU:
@@ -348,9 +390,6 @@ void Game::render() {
         case GameState::PLAYING:
         case GameState::PAUSED:
             renderPlaying();
-            if (currentState_ == GameState::PAUSED) {
-                renderPaused();
-            }
             break;
         case GameState::GAME_OVER:
             renderGameOver();
@@ -364,6 +403,13 @@ void Game::render() {
     }
 
     renderUI();
+
+    // Draw the queued world and HUD sprites, then overlays on top of them
+    renderer_->flushQueue();
+    if (currentState_ == GameState::PAUSED) {
+        renderPaused();
+    }
+
     renderer_->present();
 }
 
@@ -468,9 +514,11 @@ void Game::updatePlaying() {
         player2_->update();
     }
 
-    // Update enemies
+    // Update enemies (on large arenas only those near the players' view).
+    // Paths see the terrain as bullets left it last update.
+    pathfinder_.sync(levelManager_->getCurrentLevelData(), levelManager_->getTerrainJournal());
     for (auto& enemy : enemies_) {
-        if (enemy && enemy->isActive()) {
+        if (enemy && enemy->isActive() && isInActiveArea(enemy->getPosition())) {
             enemy->update();
         }
     }
@@ -479,10 +527,16 @@ void Game::updatePlaying() {
     for (auto& bullet : bullets_) {
         if (bullet && bullet->isActive()) {
             bullet->update();
+            if (!isInActiveArea(bullet->getPosition())) {
+                bullet->deactivate();
+                continue;
+            }
 
             // Check bullet collisions
             // With terrain
             if (bullet->checkCollisionWithTerrain(*levelManager_)) {
+                Vector2 hitPos = bullet->getPosition();
+                effects_.spawn(EffectType::BULLET_HIT, hitPos.pixelX() + 1, hitPos.pixelY() + 1);
                 continue;
             }
 
@@ -496,6 +550,10 @@ void Game::updatePlaying() {
             // With players
             if (player1_ && bullet->getOwner() == BulletOwner::ENEMY) {
                 if (bullet->checkCollisionWithTank(*player1_)) {
+                    if (!player1_->isActive()) {
+                        Vector2 tankPos = player1_->getPosition();
+                        effects_.spawn(EffectType::TANK_EXPLOSION, tankPos.pixelX() + 4, tankPos.pixelY() + 4);
+                    }
                     if (player1_->isGameOver()) {
                         changeState(GameState::GAME_OVER);
                     }
@@ -504,6 +562,10 @@ void Game::updatePlaying() {
             }
             if (player2_ && isTwoPlayerMode_ && bullet->getOwner() == BulletOwner::ENEMY) {
                 if (bullet->checkCollisionWithTank(*player2_)) {
+                    if (!player2_->isActive()) {
+                        Vector2 tankPos = player2_->getPosition();
+                        effects_.spawn(EffectType::TANK_EXPLOSION, tankPos.pixelX() + 4, tankPos.pixelY() + 4);
+                    }
                     if (player2_->isGameOver()) {
                         changeState(GameState::GAME_OVER);
                     }
@@ -525,6 +587,7 @@ void Game::updatePlaying() {
                             }
 
                             enemy->destroy();
+                            effects_.spawn(EffectType::TANK_EXPLOSION, enemyPos.pixelX() + 4, enemyPos.pixelY() + 4);
                             levelManager_->enemyDestroyed();
 
                             // Check if should spawn power-up
@@ -566,6 +629,10 @@ void Game::updatePlaying() {
     // Check power-up collisions
     checkPowerUpCollisions();
 
+    // Advance effects; enemies whose spawn star finished appear now
+    effects_.update();
+    activatePendingSpawns();
+
     // Update level (only spawn enemies when playing)
     levelManager_->update(currentState_ == GameState::PLAYING);
 
@@ -616,12 +683,12 @@ void Game::renderMenu() {
     int titleX = (renderer_->getWidth() - titleWidth) / 2; // Center horizontally
     int titleY = 100; // Y position between 80-120
     
-    // Calculate fade-in alpha (0.0 to 1.0)
-    float titleAlpha = (menuFadeInFrame_ < 30) ? (menuFadeInFrame_ / 30.0f) : 1.0f;
-    
-    // For now, render title (full implementation would use alpha blending)
+    // Fade the title in by stepping its color up the NES brightness rows
+    int titleSteps = std::min(menuFadeInFrame_, 30) * PaletteEffects::MAX_BRIGHTNESS_STEPS / 30 -
+                     PaletteEffects::MAX_BRIGHTNESS_STEPS;
     if (menuFadeInFrame_ > 0) {
-        renderer_->drawText(titleX, titleY, titleText, BattleCityPalette::COLOR_WHITE);
+        renderer_->drawText(titleX, titleY, titleText,
+                            PaletteEffects::stepBrightness(BattleCityPalette::COLOR_WHITE, titleSteps));
     }
 
     // Render menu options with slide-in animation (0.3s = 18 frames, starts after 10 frames)
@@ -697,10 +764,12 @@ void Game::renderPlaying() {
         // Use yellow/gold color for stage text
         renderer_->drawText(stageTextX, stageTextY, stageText, BattleCityPalette::COLOR_YELLOW_SELECTED);
         
-        // Transition animation: fade in for first 30 frames, hold for 60 frames, fade out for last 30 frames
-        // For now, just show the text (full alpha blending would be implemented with SDL_SetRenderDrawBlendMode)
+        // Fade in and out in NES brightness steps (4 frames per step)
+        int fadeFrames = std::min(stageTransitionFrame_, 90 - stageTransitionFrame_);
+        renderer_->setBrightness(std::min(0, fadeFrames / 4 - PaletteEffects::MAX_BRIGHTNESS_STEPS));
     } else {
         // Render level terrain
+        updateCamera();
         levelManager_->render(*renderer_);
 
         // Render players
@@ -732,15 +801,41 @@ void Game::renderPlaying() {
             }
         }
 
-        // Render HUD
-        int score = player1_ ? player1_->getScore() : 0;
-        int lives = player1_ ? player1_->getLives() : 0;
-        int level = getCurrentLevel();
-        bool twoPlayerMode = isTwoPlayerMode();
-        hud_.render(*renderer_, score, lives, level, twoPlayerMode);
+        effects_.render(*renderer_);
+
+        // HUD is drawn by renderUI()
     }
 }
 
+void Game::updateCamera() {
+    // Follow the players, centered on both in a two player game; stages
+    // that fit on screen never scroll
+    Vector2 focus = Vector2::fromPixels(0, 0);
+    int count = 0;
+    for (const PlayerTank* player : {player1_.get(), isTwoPlayerMode_ ? player2_.get() : nullptr}) {
+        if (player && player->isActive()) {
+            focus = focus + player->getPosition();
+            ++count;
+        }
+    }
+    if (count == 0) return;  // Keep the last view while nobody is on the field
+
+    Rect world = levelManager_->getWorldBounds();
+    int x = std::clamp(focus.pixelX() / count - renderer_->getWidth() / 2, 0,
+                       std::max(0, world.w - renderer_->getWidth()));
+    int y = std::clamp(focus.pixelY() / count - renderer_->getHeight() / 2, 0,
+                       std::max(0, world.h - renderer_->getHeight()));
+    renderer_->setCamera(x, y);
+}
+
+bool Game::isInActiveArea(const Vector2& position) const {
+    Rect view = renderer_->getView();
+    int x = position.pixelX();
+    int y = position.pixelY();
+    return x >= view.x - ACTIVE_MARGIN && x < view.x + view.w + ACTIVE_MARGIN &&
+           y >= view.y - ACTIVE_MARGIN && y < view.y + view.h + ACTIVE_MARGIN;
+}
+
 void Game::renderPaused() {
     // Render pause overlay
     renderer_->drawText(120, 100, "PAUSED", BattleCityPalette::COLOR_WHITE);
@@ -784,9 +879,6 @@ void Game::renderPlayingUI() {
         int level = currentLevel_;
         bool isTwoPlayerMode = isTwoPlayerMode_;
 
-        std::cout << "Game::renderPlayingUI calling HUD::render with score=" << score
-                  << " lives=" << lives << " level=" << level << " twoPlayer=" << isTwoPlayerMode << std::endl;
-
         hud_.render(*renderer_, score, lives, level, isTwoPlayerMode);
     } else {
         // Fallback to basic HUD if no player
@@ -853,6 +945,8 @@ void Game::initPlayers() {
 
 void Game::cleanupLevel() {
     // Reset level-specific objects
+    effects_.clear();
+    pendingSpawns_.clear();
     // enemyManager_->clear();
     // powerUpManager_->clear();
     // bulletManager_->clear();
@@ -3,13 +3,16 @@
 #include "Timer.h"
 #include "Random.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/EffectSystem.h"
 #include "../input/InputManager.h"
 #include "../gameplay/PlayerTank.h"
 #include "../gameplay/EnemyTank.h"
 #include "../gameplay/Bullet.h"
 #include "../gameplay/PowerUp.h"
 #include "../level/LevelManager.h"
+#include "../ai/Pathfinder.h"
 #include "../ui/HUD.h"
+#include "../utils/AssetPack.h"
 #include <memory>
 #include <vector>
 
@@ -18,7 +21,11 @@ namespace BattleCity {
 // Main game class - central controller
 class Game {
 private:
+    static constexpr int MAX_ENEMIES = 4;            // On screen at once (original game)
+    static constexpr int ACTIVE_MARGIN = 256;        // Off-screen distance at which enemies and bullets pause
+
     // Core systems
+    AssetPack assetPack_;  // Mapped for the whole run, the atlas points into it
     std::unique_ptr<Renderer> renderer_;
     std::unique_ptr<InputManager> inputManager_;
     std::unique_ptr<Timer> timer_;
@@ -41,6 +48,17 @@ private:
     // Power-ups
     std::vector<std::unique_ptr<PowerUp>> powerUps_;
 
+    // Explosions, spawn stars and shields
+    EffectSystem effects_;
+
+    // Enemies that appear once their spawn star has finished
+    struct PendingSpawn {
+        EnemyType type;
+        Vector2 position;
+        EffectHandle star;
+    };
+    std::vector<PendingSpawn> pendingSpawns_;
+
     // UI
     HUD hud_;
 
@@ -68,6 +86,9 @@ private:
     // Level management
     std::unique_ptr<LevelManager> levelManager_;
 
+    // Enemy navigation, kept in step with the terrain every update
+    Pathfinder pathfinder_;
+
     // Game timing
     uint64_t gameStartTime_;
     bool isPaused_;
@@ -81,6 +102,9 @@ public:
     bool run(); // Returns true if game should exit
     void shutdown();
 
+    // Record the session (see FrameCapture); call after init()
+    bool startCapture(const CaptureSettings& settings) { return renderer_->startCapture(settings); }
+
     // Game state management
     void changeState(GameState newState);
     GameState getCurrentState() const { return currentState_; }
@@ -107,6 +131,8 @@ public:
     // Enemy management
     void spawnEnemy(EnemyType type, const Vector2& position);
 
+    void activatePendingSpawns();
+
     // Power-up management
     void spawnPowerUp(const Vector2& position);
     void checkPowerUpCollisions();
@@ -115,6 +141,9 @@ public:
     PlayerTank* getPlayer1() const { return player1_.get(); }
     PlayerTank* getPlayer2() const { return player2_.get(); }
     int getCurrentLevel() const { return levelManager_->getCurrentLevel(); }
+    const LevelManager* getLevelManager() const { return levelManager_.get(); }
+    Pathfinder& getPathfinder() { return pathfinder_; }
+    EffectSystem& getEffects() { return effects_; }
     bool isTwoPlayerMode() const { return player2_ != nullptr; }
 
 private:
@@ -145,6 +174,8 @@ private:
     void resetGame();
     void initPlayers();
     void cleanupLevel();
+    void updateCamera();
+    bool isInActiveArea(const Vector2& position) const;
 };
 
 } // namespace BattleCity
\ No newline at end of file
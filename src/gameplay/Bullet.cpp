@@ -71,19 +71,20 @@ bool Bullet::checkCollisionWithTerrain(LevelManager& levelManager) {
     int pixelX = position_.pixelX();
     int pixelY = position_.pixelY();
 
-    // Check terrain collision
-    TerrainType terrain = levelManager.getTerrain(pixelX, pixelY);
+    // Check terrain collision (brick only where its cells still stand)
+    TerrainType terrain = levelManager.getTerrainAtPixel(pixelX, pixelY);
     if (terrain != TerrainType::GRASS && !canPenetrate(terrain)) {
         // Handle terrain destruction
-        if (terrain == TerrainType::BRICK) {
-            levelManager.destroyBrick(pixelX, pixelY);
+        if (terrain == TerrainType::BRICK || terrain == TerrainType::BASE_BRICK) {
+            levelManager.damageBricks(pixelX, pixelY, direction_, power_);
         }
         deactivate();
         return true;
     }
 
-    // Check screen boundaries
-    if (pixelX < 0 || pixelX >= 256 || pixelY < 0 || pixelY >= 224) {
+    // Check world boundaries
+    Rect world = levelManager.getWorldBounds();
+    if (pixelX < 0 || pixelX >= world.w || pixelY < 0 || pixelY >= world.h) {
         deactivate();
         return true;
     }
@@ -131,6 +132,13 @@ void Bullet::setLifetime(int frames) {
 void Bullet::render(Renderer& renderer) const {
     if (!isActive_) return;
 
+    // Atlas bullet art is rotated per direction and centered on the position
+    SpriteId sprite = renderer.getAtlas().getBullet(direction_);
+    if (sprite != INVALID_SPRITE) {
+        renderer.queueSpriteCentered(RenderLayer::BULLETS, sprite, position_.pixelX(), position_.pixelY());
+        return;
+    }
+
     int x = position_.pixelX() - 2; // Center the 4x4 sprite
     int y = position_.pixelY() - 2;
 
@@ -138,18 +146,19 @@ void Bullet::render(Renderer& renderer) const {
     const uint8_t* spriteData = getSpriteData();
     uint8_t colorIndex = (owner_ == BulletOwner::ENEMY) ? 0x06 : 0x20; // Orange for enemy, white for player
 
-    renderer.drawSprite(x, y, spriteData, colorIndex);
+    renderer.queuePattern(RenderLayer::BULLETS, x, y, spriteData, 4, colorIndex);
 }
 
 bool Bullet::isValidPosition(const Vector2& pos, LevelManager& levelManager) const {
     int pixelX = pos.pixelX();
     int pixelY = pos.pixelY();
 
-    if (pixelX < 0 || pixelX >= 256 || pixelY < 0 || pixelY >= 224) {
+    Rect world = levelManager.getWorldBounds();
+    if (pixelX < 0 || pixelX >= world.w || pixelY < 0 || pixelY >= world.h) {
         return false;
     }
 
-    TerrainType terrain = levelManager.getTerrain(pixelX, pixelY);
+    TerrainType terrain = levelManager.getTerrainAtPixel(pixelX, pixelY);
     return terrain == TerrainType::GRASS || canPenetrate(terrain);
 }
 
@@ -163,6 +172,8 @@ bool Bullet::canPenetrate(TerrainType terrain) const {
             return power_ >= 2; // Need level 2+ to penetrate steel
         case TerrainType::WATER:
             return true; // Bullets can travel through water
+        case TerrainType::FOREST:
+            return true;
         default:
             return false;
     }
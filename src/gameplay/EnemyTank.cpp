@@ -1,4 +1,6 @@
 #include "EnemyTank.h"
+#include "../core/Game.h"
+#include <cstdlib>
 
 namespace BattleCity {
 
@@ -43,9 +45,13 @@ void EnemyTank::render(Renderer& renderer) {
     int x = position_.pixelX();
     int y = position_.pixelY();
 
-    // Render tank sprite based on type
-    // TODO: Use proper sprite data
-    renderer.fillRect(x, y, 8, 8, BattleCityPalette::COLOR_GRAY);
+    // Render tank sprite based on type (gray block if sprites are not loaded)
+    SpriteId sprite = renderer.getAtlas().getEnemyTank(type_, 0, direction_, animationFrame_);
+    if (sprite != INVALID_SPRITE) {
+        renderer.queueSpriteCentered(RenderLayer::ENTITIES, sprite, x + 4, y + 4);
+    } else {
+        renderer.queueRect(RenderLayer::ENTITIES, x, y, 8, 8, BattleCityPalette::COLOR_GRAY);
+    }
 }
 
 void EnemyTank::shoot() {
@@ -94,9 +100,34 @@ BulletOwner EnemyTank::getBulletOwner() const {
 }
 
 Vector2 EnemyTank::getPlayerPosition() const {
-    // TODO: Get actual player position from game
-    // For now, return a default position
-    return Vector2::fromPixels(120, 200); // Approximate player position
+    Vector2 nearest = getBasePosition();
+    int nearestDistance = -1;
+    if (!game_) return nearest;
+
+    for (const PlayerTank* player : {game_->getPlayer1(), game_->getPlayer2()}) {
+        if (!player || !player->isActive()) continue;
+        Vector2 delta = player->getPosition() - position_;
+        int distance = std::abs(delta.pixelX()) + std::abs(delta.pixelY());
+        if (nearestDistance < 0 || distance < nearestDistance) {
+            nearest = player->getPosition();
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+Vector2 EnemyTank::getBasePosition() const {
+    if (!game_ || !game_->getLevelManager()) return Vector2::fromPixels(120, 200);
+    return game_->getLevelManager()->getCurrentLevelData().basePosition;
+}
+
+PathStep EnemyTank::findPathTo(const Vector2& target) const {
+    if (!game_) return {false, direction_, false, 0};
+
+    // Tiles under the tank's center and the target point
+    const int tileSize = 16;
+    return game_->getPathfinder().findPath((position_.pixelX() + 4) / tileSize, (position_.pixelY() + 4) / tileSize,
+                                           target.pixelX() / tileSize, target.pixelY() / tileSize);
 }
 
 } // namespace BattleCity
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Tank.h"
 #include "../ai/AIController.h"
+#include "../ai/Pathfinder.h"
 
 namespace BattleCity {
 
@@ -23,7 +24,9 @@ public:
     // AI helper methods
     bool wasHit() const { return false; } // TODO: Implement hit detection
     bool collidedWithPlayer() const { return false; } // TODO: Implement collision detection
-    Vector2 getPlayerPosition() const; // TODO: Get from game state
+    Vector2 getPlayerPosition() const;  // Nearest active player (the base if there is none)
+    Vector2 getBasePosition() const;
+    PathStep findPathTo(const Vector2& target) const;  // First step towards target (pixels)
 
 protected:
     int getMoveSpeed() const override;
@@ -1,10 +1,11 @@
 #include "PlayerTank.h"
+#include "../core/Game.h"
 
 namespace BattleCity {
 
 PlayerTank::PlayerTank(int playerIndex, Game* game)
     : Tank(game), playerIndex_(playerIndex), lives_(3), score_(0),
-      hasShield_(false), shieldTimer_(0) {
+      hasShield_(false), shieldTimer_(0), shieldEffect_(INVALID_EFFECT) {
     // Initialize tank properties
     maxHealth_ = 1;
     health_ = 1;
@@ -36,13 +37,13 @@ void PlayerTank::render(Renderer& renderer) {
     int x = position_.pixelX();
     int y = position_.pixelY();
 
-    // Render tank sprite
-    const uint8_t* spriteData = getSpriteData();
-    renderer.drawSprite(x, y, spriteData);
-
-    // Render shield effect if active
-    if (hasShield_) {
-        renderShield(renderer);
+    // Render tank sprite (atlas art centered on the 8x8 hitbox, placeholder if not loaded)
+    SpriteId sprite = renderer.getAtlas().getPlayerTank(playerIndex_, level_, direction_, animationFrame_);
+    if (sprite != INVALID_SPRITE) {
+        renderer.queueSpriteCentered(RenderLayer::ENTITIES, sprite, x + 4, y + 4);
+    } else {
+        const uint8_t* spriteData = getSpriteData();
+        renderer.queuePattern(RenderLayer::ENTITIES, x, y, spriteData, 8);
     }
 }
 
@@ -115,8 +116,7 @@ void PlayerTank::loseLife() {
         // Reset tank for respawn
         health_ = maxHealth_;
         level_ = 0;
-        invincible_ = false;
-        hasShield_ = false;
+        deactivateShield();
         position_ = getSpawnPosition();
     }
 }
@@ -133,12 +133,23 @@ void PlayerTank::activateShield(int frames) {
     hasShield_ = true;
     shieldTimer_ = frames;
     invincible_ = true; // Shield provides invincibility
+
+    if (game_) {
+        EffectSystem& effects = game_->getEffects();
+        effects.stop(shieldEffect_);
+        shieldEffect_ = effects.spawn(EffectType::SHIELD, position_.pixelX() + 4, position_.pixelY() + 4, frames);
+    }
 }
 
 void PlayerTank::deactivateShield() {
     hasShield_ = false;
     shieldTimer_ = 0;
     invincible_ = false;
+
+    if (game_) {
+        game_->getEffects().stop(shieldEffect_);
+    }
+    shieldEffect_ = INVALID_EFFECT;
 }
 
 int PlayerTank::getMoveSpeed() const {
@@ -173,22 +184,12 @@ void PlayerTank::updateShield() {
         shieldTimer_--;
         if (shieldTimer_ <= 0) {
             deactivateShield();
+        } else if (game_) {
+            game_->getEffects().move(shieldEffect_, position_.pixelX() + 4, position_.pixelY() + 4);
         }
     }
 }
 
-void PlayerTank::renderShield(Renderer& renderer) const {
-    int x = position_.pixelX();
-    int y = position_.pixelY();
-
-    // Shield blinking effect (2 frames alternating)
-    int blinkFrame = (shieldTimer_ / 3) % 2; // 3 frames per blink phase
-    uint8_t color = blinkFrame == 0 ? BattleCityPalette::COLOR_WHITE : BattleCityPalette::COLOR_CYAN;
-
-    // Draw shield outline
-    renderer.drawRect(x - 1, y - 1, 10, 10, color);
-}
-
 const uint8_t* PlayerTank::getSpriteData() const {
     // Return appropriate sprite based on direction and level
     // This would use TankSprites class
@@ -2,6 +2,7 @@
 
 #include "Tank.h"
 #include "../input/InputManager.h"
+#include "../graphics/EffectSystem.h"
 
 namespace BattleCity {
 
@@ -13,6 +14,7 @@ private:
     int tankLevel_;             // Tank upgrade level (0-3)
     bool hasShield_;            // Shield power-up status
     int shieldTimer_;           // Shield duration
+    EffectHandle shieldEffect_; // Shield drawn by the game's effect system
 
 public:
     PlayerTank(int playerIndex = 0, Game* game = nullptr);
@@ -55,7 +57,6 @@ protected:
 
 private:
     void updateShield();
-    void renderShield(Renderer& renderer) const;
     const uint8_t* getSpriteData() const;
 };
 
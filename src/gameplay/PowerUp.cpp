@@ -32,6 +32,13 @@ void PowerUp::update() {
 void PowerUp::render(Renderer& renderer) const {
     if (!isActive_) return;
 
+    // 优先使用图集中的道具图标（居中绘制）
+    SpriteId sprite = renderer.getAtlas().getPowerUp(type_);
+    if (sprite != INVALID_SPRITE) {
+        renderer.queueSpriteCentered(RenderLayer::ENTITIES, sprite, position_.pixelX(), position_.pixelY());
+        return;
+    }
+
     int x = position_.pixelX() - 4; // 8x8精灵居中
     int y = position_.pixelY() - 4;
 
@@ -47,7 +54,7 @@ void PowerUp::render(Renderer& renderer) const {
         case PowerUpType::CLEAR_ENEMIES:colorIndex = 0x06; break; // 橙色
     }
 
-    renderer.drawSprite(x, y, spriteData, colorIndex);
+    renderer.queuePattern(RenderLayer::ENTITIES, x, y, spriteData, 8, colorIndex);
 }
 
 Rect PowerUp::getBounds() const {
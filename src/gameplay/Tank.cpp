@@ -131,17 +131,24 @@ void Tank::updateCooldown() {
 }
 
 bool Tank::canMoveTo(const Vector2& newPos) const {
-    // Check screen bounds
+    // Check world bounds (the screen when there is no level)
     int pixelX = newPos.pixelX();
     int pixelY = newPos.pixelY();
+    Rect world(0, 0, 256, 224);
+    if (game_ && game_->getLevelManager()) {
+        world = game_->getLevelManager()->getWorldBounds();
+    }
 
-    if (pixelX < 0 || pixelX > 256 - 8 || pixelY < 0 || pixelY > 224 - 8) {
+    if (pixelX < 0 || pixelX > world.w - 8 || pixelY < 0 || pixelY > world.h - 8) {
         return false;
     }
 
-    // Check terrain collision (would be implemented with terrain system)
-    // For now, allow all movement
-    return true;
+    // Terrain collision on the 8x8 box. A tank already overlapping walls
+    // (spawned inside them) may still drive out.
+    if (!game_ || !game_->getLevelManager()) return true;
+    const LevelManager* level = game_->getLevelManager();
+    if (!level->isAreaBlocked(Rect(pixelX, pixelY, 8, 8))) return true;
+    return level->isAreaBlocked(Rect(position_.pixelX(), position_.pixelY(), 8, 8));
 }
 
 } // namespace BattleCity
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "BitmapFont.h"
+#include <algorithm>
+#include <cstring>
+
+namespace BattleCity {
+
+namespace {
+
+// Font data (8x8 pixel monospace font, NES style)
+constexpr uint8_t FONT_DATA[BitmapFont::GLYPH_COUNT][BitmapFont::GLYPH_SIZE] = {
+    // Space (32)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // ! (33)
+    {0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x00},
+    // " (34)
+    {0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // # (35)
+    {0x24, 0x7E, 0x24, 0x24, 0x7E, 0x24, 0x24, 0x00},
+    // $ (36)
+    {0x08, 0x3E, 0x48, 0x3C, 0x12, 0x7C, 0x10, 0x00},
+    // % (37)
+    {0x60, 0x66, 0x0C, 0x18, 0x30, 0x66, 0x06, 0x00},
+    // & (38)
+    {0x3C, 0x42, 0x3C, 0x42, 0x42, 0x3C, 0x02, 0x00},
+    // ' (39)
+    {0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // ( (40)
+    {0x0C, 0x18, 0x30, 0x30, 0x30, 0x18, 0x0C, 0x00},
+    // ) (41)
+    {0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x18, 0x30, 0x00},
+    // * (42)
+    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},
+    // + (43)
+    {0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x00},
+    // , (44)
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30, 0x00},
+    // - (45)
+    {0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00},
+    // . (46)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00},
+    // / (47)
+    {0x00, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x00, 0x00},
+    // Numbers 0-9 (48-57)
+    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // 0
+    {0x08, 0x18, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // 1
+    {0x3C, 0x42, 0x02, 0x3C, 0x40, 0x40, 0x7E, 0x00}, // 2
+    {0x3C, 0x42, 0x02, 0x1C, 0x02, 0x42, 0x3C, 0x00}, // 3
+    {0x04, 0x0C, 0x14, 0x24, 0x7E, 0x04, 0x04, 0x00}, // 4
+    {0x7E, 0x40, 0x7C, 0x02, 0x02, 0x42, 0x3C, 0x00}, // 5
+    {0x3C, 0x40, 0x7C, 0x42, 0x42, 0x42, 0x3C, 0x00}, // 6
+    {0x7E, 0x02, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00}, // 7
+    {0x3C, 0x42, 0x42, 0x3C, 0x42, 0x42, 0x3C, 0x00}, // 8
+    {0x3C, 0x42, 0x42, 0x3E, 0x02, 0x42, 0x3C, 0x00}, // 9
+    // : (58)
+    {0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00},
+    // ; (59)
+    {0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x30, 0x00},
+    // < (60)
+    {0x0C, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x00},
+    // = (61)
+    {0x00, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x00, 0x00},
+    // > (62)
+    {0x30, 0x18, 0x0C, 0x06, 0x0C, 0x18, 0x30, 0x00},
+    // ? (63)
+    {0x3C, 0x42, 0x04, 0x08, 0x08, 0x00, 0x08, 0x00},
+    // @ (64)
+    {0x3C, 0x42, 0x4E, 0x52, 0x4E, 0x40, 0x3C, 0x00},
+    // Uppercase A-Z (65-90)
+    {0x18, 0x24, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x00}, // A
+    {0x7C, 0x42, 0x42, 0x7C, 0x42, 0x42, 0x7C, 0x00}, // B
+    {0x3C, 0x42, 0x40, 0x40, 0x40, 0x42, 0x3C, 0x00}, // C
+    {0x78, 0x44, 0x42, 0x42, 0x42, 0x44, 0x78, 0x00}, // D
+    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x7E, 0x00}, // E
+    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x40, 0x00}, // F
+    {0x3C, 0x42, 0x40, 0x4E, 0x42, 0x42, 0x3C, 0x00}, // G
+    {0x42, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x42, 0x00}, // H
+    {0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // I
+    {0x02, 0x02, 0x02, 0x02, 0x42, 0x42, 0x3C, 0x00}, // J
+    {0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00}, // K
+    {0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7E, 0x00}, // L
+    {0x42, 0x66, 0x5A, 0x42, 0x42, 0x42, 0x42, 0x00}, // M
+    {0x42, 0x62, 0x52, 0x4A, 0x46, 0x42, 0x42, 0x00}, // N
+    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // O
+    {0x7C, 0x42, 0x42, 0x7C, 0x40, 0x40, 0x40, 0x00}, // P
+    {0x3C, 0x42, 0x42, 0x42, 0x4A, 0x44, 0x3A, 0x00}, // Q
+    {0x7C, 0x42, 0x42, 0x7C, 0x48, 0x44, 0x42, 0x00}, // R
+    {0x3C, 0x42, 0x40, 0x3C, 0x02, 0x42, 0x3C, 0x00}, // S
+    {0x7E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // T
+    {0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // U
+    {0x42, 0x42, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00}, // V
+    {0x42, 0x42, 0x42, 0x42, 0x5A, 0x66, 0x42, 0x00}, // W
+    {0x42, 0x24, 0x18, 0x18, 0x18, 0x24, 0x42, 0x00}, // X
+    {0x42, 0x42, 0x24, 0x18, 0x18, 0x18, 0x18, 0x00}, // Y
+    {0x7E, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7E, 0x00}, // Z (90)
+    // Fill remaining slots with empty (for characters 91-127)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // [ (91)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // \ (92)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ] (93)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ^ (94)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // _ (95)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ` (96)
+    // Lowercase a-z (97-122) - using uppercase glyphs for now
+    {0x18, 0x24, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x00}, // a (97)
+    {0x7C, 0x42, 0x42, 0x7C, 0x42, 0x42, 0x7C, 0x00}, // b (98)
+    {0x3C, 0x42, 0x40, 0x40, 0x40, 0x42, 0x3C, 0x00}, // c (99)
+    {0x78, 0x44, 0x42, 0x42, 0x42, 0x44, 0x78, 0x00}, // d (100)
+    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x7E, 0x00}, // e (101)
+    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x40, 0x00}, // f (102)
+    {0x3C, 0x42, 0x40, 0x4E, 0x42, 0x42, 0x3C, 0x00}, // g (103)
+    {0x42, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x42, 0x00}, // h (104)
+    {0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // i (105)
+    {0x02, 0x02, 0x02, 0x02, 0x42, 0x42, 0x3C, 0x00}, // j (106)
+    {0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00}, // k (107)
+    {0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7E, 0x00}, // l (108)
+    {0x42, 0x66, 0x5A, 0x42, 0x42, 0x42, 0x42, 0x00}, // m (109)
+    {0x42, 0x62, 0x52, 0x4A, 0x46, 0x42, 0x42, 0x00}, // n (110)
+    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // o (111)
+    {0x7C, 0x42, 0x42, 0x7C, 0x40, 0x40, 0x40, 0x00}, // p (112)
+    {0x3C, 0x42, 0x42, 0x42, 0x4A, 0x44, 0x3A, 0x00}, // q (113)
+    {0x7C, 0x42, 0x42, 0x7C, 0x48, 0x44, 0x42, 0x00}, // r (114)
+    {0x3C, 0x42, 0x40, 0x3C, 0x02, 0x42, 0x3C, 0x00}, // s (115)
+    {0x7E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // t (116)
+    {0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // u (117)
+    {0x42, 0x42, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00}, // v (118)
+    {0x42, 0x42, 0x42, 0x42, 0x5A, 0x66, 0x42, 0x00}, // w (119)
+    {0x42, 0x24, 0x18, 0x18, 0x18, 0x24, 0x42, 0x00}, // x (120)
+    {0x42, 0x42, 0x24, 0x18, 0x18, 0x18, 0x18, 0x00}, // y (121)
+    {0x7E, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7E, 0x00}, // z (122)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // { (123)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // | (124)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // } (125)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ~ (126)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // DEL (127)
+};
+
+struct GlyphTable {
+    uint8_t masks[BitmapFont::GLYPH_COUNT][BitmapFont::GLYPH_SIZE][BitmapFont::GLYPH_SIZE];
+    bool blank[BitmapFont::GLYPH_COUNT];
+
+    constexpr GlyphTable() : masks(), blank() {
+        for (int glyph = 0; glyph < BitmapFont::GLYPH_COUNT; ++glyph) {
+            blank[glyph] = true;
+            for (int row = 0; row < BitmapFont::GLYPH_SIZE; ++row) {
+                for (int col = 0; col < BitmapFont::GLYPH_SIZE; ++col) {
+                    bool lit = (FONT_DATA[glyph][row] & (0x80 >> col)) != 0;
+                    masks[glyph][row][col] = lit ? 0xFF : 0x00;
+                    if (lit) blank[glyph] = false;
+                }
+            }
+        }
+    }
+};
+
+constexpr GlyphTable GLYPHS;
+
+} // namespace
+
+const uint8_t (*BitmapFont::getGlyph(char c))[GLYPH_SIZE] {
+    int index = static_cast<unsigned char>(c) - FIRST_CHAR;
+    if (index < 0 || index >= GLYPH_COUNT || GLYPHS.blank[index]) return nullptr;
+    return GLYPHS.masks[index];
+}
+
+void BitmapFont::drawText(IndexedSurface& surface, int x, int y, const char* text, uint8_t colorIndex) {
+    if (text == nullptr) return;
+
+    // Rows of the glyphs that fall inside the surface
+    int firstRow = std::max(0, -y);
+    int lastRow = std::min(GLYPH_SIZE, surface.getHeight() - y);
+    if (firstRow >= lastRow) return;
+
+    const uint64_t color = 0x0101010101010101ull * colorIndex;
+
+    for (int glyphX = x; *text; ++text, glyphX += GLYPH_SIZE) {
+        if (glyphX >= surface.getWidth()) break;
+        if (glyphX <= -GLYPH_SIZE) continue;
+
+        const uint8_t (*glyph)[GLYPH_SIZE] = getGlyph(*text);
+        if (!glyph) continue;
+
+        if (glyphX >= 0 && glyphX + GLYPH_SIZE <= surface.getWidth()) {
+            // Fully visible horizontally: one masked store per row
+            for (int row = firstRow; row < lastRow; ++row) {
+                uint8_t* dst = surface.getRow(y + row) + glyphX;
+                uint64_t mask, pixels;
+                std::memcpy(&mask, glyph[row], sizeof(mask));
+                std::memcpy(&pixels, dst, sizeof(pixels));
+                pixels = (pixels & ~mask) | (color & mask);
+                std::memcpy(dst, &pixels, sizeof(pixels));
+            }
+        } else {
+            // Glyph crosses the left or right edge
+            int firstCol = std::max(0, -glyphX);
+            int lastCol = std::min(GLYPH_SIZE, surface.getWidth() - glyphX);
+            for (int row = firstRow; row < lastRow; ++row) {
+                uint8_t* dst = surface.getRow(y + row) + glyphX;
+                for (int col = firstCol; col < lastCol; ++col) {
+                    if (glyph[row][col]) dst[col] = colorIndex;
+                }
+            }
+        }
+    }
+}
+
+} // namespace BattleCity
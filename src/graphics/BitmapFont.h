@@ -0,0 +1,24 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include <cstdint>
+
+namespace BattleCity {
+
+// 8x8 NES-style font (ASCII 32-127). Glyph rows are expanded at compile time
+// to one byte per pixel (0xFF lit, 0x00 clear), so a glyph row is drawn with
+// a single masked 8-byte store instead of eight bit tests and setPixel calls.
+class BitmapFont {
+public:
+    static constexpr int GLYPH_SIZE = 8;
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int GLYPH_COUNT = 96;
+
+    // Expanded rows of a character, nullptr for blank or unsupported characters
+    static const uint8_t (*getGlyph(char c))[GLYPH_SIZE];
+
+    // Draw text into a surface (clipped to its bounds)
+    static void drawText(IndexedSurface& surface, int x, int y, const char* text, uint8_t colorIndex);
+};
+
+} // namespace BattleCity
@@ -0,0 +1,103 @@
+#include "DirtyRectTracker.h"
+#include <algorithm>
+#include <cstring>
+
+namespace BattleCity {
+
+namespace {
+
+// Above this share of the screen a single full upload is cheaper than many rects
+constexpr int FULL_UPLOAD_PERCENT = 60;
+
+} // namespace
+
+DirtyRectTracker::DirtyRectTracker() : fullRedraw_(true), dirtyArea_(0) {
+}
+
+const std::vector<Rect>& DirtyRectTracker::update(const IndexedSurface& frame) {
+    rects_.clear();
+    dirtyArea_ = 0;
+
+    int width = frame.getWidth();
+    int height = frame.getHeight();
+    if (width == 0 || height == 0) return rects_;
+
+    if (fullRedraw_ || previous_.getWidth() != width || previous_.getHeight() != height) {
+        previous_ = frame;
+        fullRedraw_ = false;
+        rects_.push_back(frame.getBounds());
+        dirtyArea_ = width * height;
+        return rects_;
+    }
+
+    int columns = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    int rows = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    dirtyBlocks_.assign(static_cast<size_t>(columns) * rows, false);
+    for (int blockY = 0; blockY < rows; ++blockY) {
+        for (int blockX = 0; blockX < columns; ++blockX) {
+            dirtyBlocks_[blockY * columns + blockX] = isBlockDirty(frame, blockX, blockY);
+        }
+    }
+
+    mergeBlocks(columns, rows, width, height);
+
+    for (const Rect& rect : rects_) {
+        dirtyArea_ += rect.w * rect.h;
+    }
+    if (dirtyArea_ * 100 > width * height * FULL_UPLOAD_PERCENT) {
+        rects_.assign(1, frame.getBounds());
+        dirtyArea_ = width * height;
+    }
+
+    // Remember only what changed
+    for (const Rect& rect : rects_) {
+        previous_.blit(frame, rect, rect.x, rect.y);
+    }
+    return rects_;
+}
+
+bool DirtyRectTracker::isBlockDirty(const IndexedSurface& frame, int blockX, int blockY) const {
+    int x = blockX * BLOCK_SIZE;
+    int y = blockY * BLOCK_SIZE;
+    int w = std::min(BLOCK_SIZE, frame.getWidth() - x);
+    int h = std::min(BLOCK_SIZE, frame.getHeight() - y);
+
+    for (int row = y; row < y + h; ++row) {
+        if (std::memcmp(frame.getRow(row) + x, previous_.getRow(row) + x, w) != 0) return true;
+    }
+    return false;
+}
+
+void DirtyRectTracker::mergeBlocks(int columns, int rows, int width, int height) {
+    for (int blockY = 0; blockY < rows; ++blockY) {
+        int y = blockY * BLOCK_SIZE;
+        int h = std::min(BLOCK_SIZE, height - y);
+
+        for (int blockX = 0; blockX < columns;) {
+            if (!dirtyBlocks_[blockY * columns + blockX]) {
+                ++blockX;
+                continue;
+            }
+
+            int start = blockX;
+            while (blockX < columns && dirtyBlocks_[blockY * columns + blockX]) ++blockX;
+            int x = start * BLOCK_SIZE;
+            int w = std::min(blockX * BLOCK_SIZE, width) - x;
+
+            // Extend a rect ending at the row above with exactly the same span
+            bool extended = false;
+            for (Rect& rect : rects_) {
+                if (rect.x == x && rect.w == w && rect.y + rect.h == y) {
+                    rect.h += h;
+                    extended = true;
+                    break;
+                }
+            }
+            if (!extended) {
+                rects_.push_back(Rect(x, y, w, h));
+            }
+        }
+    }
+}
+
+} // namespace BattleCity
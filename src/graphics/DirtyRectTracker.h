@@ -0,0 +1,45 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include "../utils/MathUtils.h"
+#include <vector>
+
+namespace BattleCity {
+
+// Finds the regions of the frame buffer that changed since the last
+// presented frame, so only those are converted and uploaded to the texture.
+//
+// The frame is compared in 16x16 blocks against a copy of the previous one.
+// That catches everything that moved or changed (entity old and new bounds,
+// destroyed bricks, animated text) without instrumenting every draw call.
+// Dirty blocks are merged into horizontal runs and then into rectangles.
+class DirtyRectTracker {
+public:
+    static constexpr int BLOCK_SIZE = 16;
+
+private:
+    IndexedSurface previous_;   // Last presented frame
+    std::vector<Rect> rects_;
+    std::vector<bool> dirtyBlocks_;
+    bool fullRedraw_;
+    int dirtyArea_;
+
+public:
+    DirtyRectTracker();
+
+    // Force the next update to report the whole frame (palette change, new texture)
+    void invalidateAll() { fullRedraw_ = true; }
+
+    // Compare the frame with the previous one and remember it.
+    // Returns the merged dirty rectangles (empty if nothing changed).
+    const std::vector<Rect>& update(const IndexedSurface& frame);
+
+    const std::vector<Rect>& getRects() const { return rects_; }
+    int getDirtyArea() const { return dirtyArea_; }
+
+private:
+    bool isBlockDirty(const IndexedSurface& frame, int blockX, int blockY) const;
+    void mergeBlocks(int columns, int rows, int width, int height);
+};
+
+} // namespace BattleCity
@@ -0,0 +1,176 @@
+#include "EffectSystem.h"
+#include "Renderer.h"
+#include <algorithm>
+
+namespace BattleCity {
+
+namespace {
+
+struct EffectArt {
+    const char* frames[EffectSystem::MAX_FRAMES];
+    int frameCount;
+    int ticksPerFrame;
+    bool looping;
+    int defaultLife;
+    int fallbackSize;         // Placeholder square when the art is missing
+    uint8_t fallbackColors[2];
+};
+
+// Indexed by EffectType
+const EffectArt EFFECT_ART[] = {
+    // BULLET_HIT: the small burst grows over three frames
+    {{"effects/boom/boom1/boom1_1", "effects/boom/boom1/boom1_2", "effects/boom/boom1/boom1_3"},
+     3, 3, false, 0, 8, {BattleCityPalette::COLOR_WHITE, BattleCityPalette::COLOR_RED}},
+    // TANK_EXPLOSION: small burst, the large one, then back down
+    {{"effects/boom/boom1/boom1_1", "effects/boom/boom1/boom1_2", "effects/boom/boom1/boom1_3",
+      "effects/boom/boom2/boom2_0", "effects/boom/boom2/boom2_1", "effects/boom/boom1/boom1_3"},
+     6, 4, false, 0, 16, {BattleCityPalette::COLOR_RED, BattleCityPalette::COLOR_YELLOW}},
+    // SPAWN_STAR: pulses in and out
+    {{"effects/star/star0", "effects/star/star1", "effects/star/star2", "effects/star/star3",
+      "effects/star/star2", "effects/star/star1"},
+     6, 3, true, 40, 8, {BattleCityPalette::COLOR_WHITE, BattleCityPalette::COLOR_CYAN}},
+    // SHIELD: two frames alternating
+    {{"effects/born_shield/bornShield0", "effects/born_shield/bornShield1"},
+     2, 2, true, 0, 10, {BattleCityPalette::COLOR_WHITE, BattleCityPalette::COLOR_CYAN}},
+};
+static_assert(sizeof(EFFECT_ART) / sizeof(EFFECT_ART[0]) == static_cast<size_t>(EffectType::COUNT),
+              "EFFECT_ART must cover every EffectType");
+
+constexpr int SLOT_BITS = 8;
+constexpr EffectHandle SLOT_MASK = (1u << SLOT_BITS) - 1;
+
+} // namespace
+
+EffectSystem::EffectSystem() : count_(0), freeCount_(0), clock_(0) {
+    for (size_t type = 0; type < animations_.size(); ++type) {
+        const EffectArt& art = EFFECT_ART[type];
+        Animation& animation = animations_[type];
+        std::fill(std::begin(animation.frames), std::end(animation.frames), INVALID_SPRITE);
+        animation.frameCount = art.frameCount;
+        animation.ticksPerFrame = art.ticksPerFrame;
+        animation.looping = art.looping;
+        animation.defaultLife = art.looping ? art.defaultLife : art.frameCount * art.ticksPerFrame;
+    }
+    slotGeneration_.fill(1);
+    clear();
+}
+
+void EffectSystem::loadSprites(const SpriteAtlas& atlas) {
+    for (size_t type = 0; type < animations_.size(); ++type) {
+        const EffectArt& art = EFFECT_ART[type];
+        for (int frame = 0; frame < art.frameCount; ++frame) {
+            animations_[type].frames[frame] = atlas.find(art.frames[frame]);
+        }
+    }
+}
+
+EffectHandle EffectSystem::spawn(EffectType type, int x, int y, int life) {
+    if (freeCount_ == 0) return INVALID_EFFECT;
+
+    uint8_t slot = freeSlots_[--freeCount_];
+    int index = count_++;
+    x_[index] = static_cast<int16_t>(x);
+    y_[index] = static_cast<int16_t>(y);
+    age_[index] = 0;
+    life_[index] = static_cast<uint16_t>(life > 0 ? life : animations_[static_cast<size_t>(type)].defaultLife);
+    type_[index] = type;
+    slot_[index] = slot;
+    slotIndex_[slot] = static_cast<uint8_t>(index);
+
+    return (static_cast<EffectHandle>(slotGeneration_[slot]) << SLOT_BITS) | (slot + 1u);
+}
+
+void EffectSystem::move(EffectHandle handle, int x, int y) {
+    int index = indexOf(handle);
+    if (index < 0) return;
+    x_[index] = static_cast<int16_t>(x);
+    y_[index] = static_cast<int16_t>(y);
+}
+
+void EffectSystem::stop(EffectHandle handle) {
+    int index = indexOf(handle);
+    if (index >= 0) removeAt(index);
+}
+
+void EffectSystem::clear() {
+    while (count_ > 0) {
+        removeAt(count_ - 1);
+    }
+    freeCount_ = CAPACITY;
+    for (int i = 0; i < CAPACITY; ++i) {
+        freeSlots_[i] = static_cast<uint8_t>(CAPACITY - 1 - i);
+    }
+}
+
+void EffectSystem::update() {
+    ++clock_;
+    for (int i = 0; i < count_;) {
+        ++age_[i];
+        if (life_[i] != 0 && age_[i] >= life_[i]) {
+            removeAt(i);  // The last effect moves into i
+        } else {
+            ++i;
+        }
+    }
+}
+
+void EffectSystem::render(Renderer& renderer) const {
+    for (int i = 0; i < count_; ++i) {
+        const Animation& animation = animations_[static_cast<size_t>(type_[i])];
+        int frame = currentFrame(i);
+        SpriteId sprite = animation.frames[frame];
+        if (sprite != INVALID_SPRITE) {
+            renderer.queueSpriteCentered(RenderLayer::EFFECTS, sprite, x_[i], y_[i]);
+            continue;
+        }
+
+        const EffectArt& art = EFFECT_ART[static_cast<size_t>(type_[i])];
+        int half = art.fallbackSize / 2;
+        uint8_t color = art.fallbackColors[frame % 2];
+        if (type_[i] == EffectType::SHIELD) {
+            renderer.queueOutline(RenderLayer::EFFECTS, x_[i] - half, y_[i] - half,
+                                  art.fallbackSize, art.fallbackSize, color);
+        } else {
+            renderer.queueRect(RenderLayer::EFFECTS, x_[i] - half, y_[i] - half,
+                               art.fallbackSize, art.fallbackSize, color);
+        }
+    }
+}
+
+int EffectSystem::getDuration(EffectType type) const {
+    return animations_[static_cast<size_t>(type)].defaultLife;
+}
+
+int EffectSystem::indexOf(EffectHandle handle) const {
+    EffectHandle slot = (handle & SLOT_MASK) - 1;
+    if (handle == INVALID_EFFECT || slot >= static_cast<EffectHandle>(CAPACITY)) return -1;
+    if (slotGeneration_[slot] != (handle >> SLOT_BITS)) return -1;
+    return slotIndex_[slot];
+}
+
+void EffectSystem::removeAt(int index) {
+    uint8_t slot = slot_[index];
+    ++slotGeneration_[slot];  // Old handles no longer match
+    if (slotGeneration_[slot] == 0) slotGeneration_[slot] = 1;
+    freeSlots_[freeCount_++] = slot;
+
+    int last = --count_;
+    if (index != last) {
+        x_[index] = x_[last];
+        y_[index] = y_[last];
+        age_[index] = age_[last];
+        life_[index] = life_[last];
+        type_[index] = type_[last];
+        slot_[index] = slot_[last];
+        slotIndex_[slot_[index]] = static_cast<uint8_t>(index);
+    }
+}
+
+int EffectSystem::currentFrame(int index) const {
+    const Animation& animation = animations_[static_cast<size_t>(type_[index])];
+    uint32_t ticks = animation.looping ? clock_ : age_[index];
+    int frame = static_cast<int>(ticks / animation.ticksPerFrame);
+    return animation.looping ? frame % animation.frameCount : std::min(frame, animation.frameCount - 1);
+}
+
+} // namespace BattleCity
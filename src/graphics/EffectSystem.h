@@ -0,0 +1,91 @@
+#pragma once
+
+#include "SpriteAtlas.h"
+#include <array>
+#include <cstdint>
+
+namespace BattleCity {
+
+class Renderer;
+
+enum class EffectType : uint8_t {
+    BULLET_HIT,       // Small burst where a bullet stops
+    TANK_EXPLOSION,   // Small burst growing into the large one
+    SPAWN_STAR,       // Pulsing star shown before a tank appears
+    SHIELD,           // Blinking force field around a tank
+    COUNT
+};
+
+// Refers to a running effect; stays safe to use after the effect has ended
+using EffectHandle = uint32_t;
+constexpr EffectHandle INVALID_EFFECT = 0;
+
+// Fixed-capacity pool of short-lived visual effects. Effects are stored as
+// parallel arrays packed at the front (ended ones are swapped out), so
+// update() and render() only touch active effects and nothing is allocated
+// after construction. When the pool is full new effects are dropped.
+//
+// Animations are per type: one-shot effects play from their own age, looping
+// ones (star, shield) read a clock shared by all effects so they blink in
+// step like on the NES.
+class EffectSystem {
+public:
+    static constexpr int CAPACITY = 64;
+    static constexpr int MAX_FRAMES = 6;
+
+private:
+    struct Animation {
+        SpriteId frames[MAX_FRAMES];
+        int frameCount;
+        int ticksPerFrame;
+        bool looping;       // Driven by the shared clock
+        int defaultLife;    // Frames, 0 = until stopped
+    };
+    std::array<Animation, static_cast<size_t>(EffectType::COUNT)> animations_;
+
+    // Active effects, indices [0, count_)
+    std::array<int16_t, CAPACITY> x_;   // Center in pixels
+    std::array<int16_t, CAPACITY> y_;
+    std::array<uint16_t, CAPACITY> age_;
+    std::array<uint16_t, CAPACITY> life_;
+    std::array<EffectType, CAPACITY> type_;
+    std::array<uint8_t, CAPACITY> slot_;   // Handle slot owning the effect
+    int count_;
+
+    // Handle slots: where the effect currently sits and a generation that
+    // invalidates old handles when the slot is reused
+    std::array<uint8_t, CAPACITY> slotIndex_;
+    std::array<uint16_t, CAPACITY> slotGeneration_;
+    std::array<uint8_t, CAPACITY> freeSlots_;
+    int freeCount_;
+
+    uint32_t clock_;
+
+public:
+    EffectSystem();
+
+    // Look up the effect art (placeholder shapes are drawn without it)
+    void loadSprites(const SpriteAtlas& atlas);
+
+    // Start an effect centered on (x, y); life 0 uses the type's default
+    EffectHandle spawn(EffectType type, int x, int y, int life = 0);
+    void move(EffectHandle handle, int x, int y);
+    void stop(EffectHandle handle);
+    bool isRunning(EffectHandle handle) const { return indexOf(handle) >= 0; }
+    void clear();
+
+    void update();
+    void render(Renderer& renderer) const;
+
+    int getActiveCount() const { return count_; }
+
+    // Frames a one-shot effect of this type lasts
+    int getDuration(EffectType type) const;
+
+private:
+    int indexOf(EffectHandle handle) const;
+    void removeAt(int index);
+    int currentFrame(int index) const;
+};
+
+} // namespace BattleCity
@@ -0,0 +1,251 @@
+#include "FrameCapture.h"
+#include "../utils/FileUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#define CAPTURE_POPEN _popen
+#define CAPTURE_PCLOSE _pclose
+#define CAPTURE_PIPE_MODE "wb"
+#else
+#include <csignal>
+#define CAPTURE_POPEN popen
+#define CAPTURE_PCLOSE pclose
+#define CAPTURE_PIPE_MODE "w"
+#endif
+
+namespace BattleCity {
+
+namespace {
+
+// Largest stored (uncompressed) deflate block
+constexpr size_t DEFLATE_BLOCK_SIZE = 65535;
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> result;
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[n] = c;
+        }
+        return result;
+    }();
+    return table;
+}
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    const std::array<uint32_t, 256>& table = crcTable();
+    crc ^= 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Append a PNG chunk; data is the chunk type followed by its payload
+void putChunk(std::vector<uint8_t>& out, const std::vector<uint8_t>& data) {
+    putBigEndian(out, static_cast<uint32_t>(data.size() - 4));
+    out.insert(out.end(), data.begin(), data.end());
+    putBigEndian(out, crc32(data.data(), data.size()));
+}
+
+} // namespace
+
+FrameCapture::FrameCapture(int width, int height)
+    : width_(width), height_(height), head_(0), tail_(0), running_(false),
+      capturedFrames_(0), droppedFrames_(0), writtenFrames_(0), frameNumber_(0), pipe_(nullptr) {
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(const CaptureSettings& settings) {
+    stop();
+    settings_ = settings;
+
+    if (settings_.format == CaptureFormat::RAW_PIPE) {
+#ifndef _WIN32
+        // A dead encoder process must not kill the game
+        std::signal(SIGPIPE, SIG_IGN);
+#endif
+        pipe_ = CAPTURE_POPEN(settings_.target.c_str(), CAPTURE_PIPE_MODE);
+        if (!pipe_) {
+            std::cerr << "Failed to start capture command: " << settings_.target << std::endl;
+            return false;
+        }
+    } else {
+        std::error_code error;
+        std::filesystem::create_directories(settings_.target, error);
+        if (error) {
+            std::cerr << "Failed to create capture directory: " << settings_.target << std::endl;
+            return false;
+        }
+    }
+
+    // One slot stays empty to tell a full ring from an empty one
+    slots_.assign(std::max(2, settings_.ringFrames) + 1, Slot());
+    for (Slot& slot : slots_) {
+        slot.pixels.resize(static_cast<size_t>(width_) * height_);
+    }
+    head_.store(0);
+    tail_.store(0);
+    capturedFrames_.store(0);
+    droppedFrames_.store(0);
+    writtenFrames_.store(0);
+    frameNumber_ = 0;
+
+    running_.store(true);
+    encoder_ = std::thread(&FrameCapture::encoderLoop, this);
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (encoder_.joinable()) {
+        running_.store(false);
+        wake_.notify_one();
+        encoder_.join();
+    }
+    running_.store(false);
+
+    if (pipe_) {
+        CAPTURE_PCLOSE(pipe_);
+        pipe_ = nullptr;
+    }
+}
+
+bool FrameCapture::submit(const IndexedSurface& frame, const uint32_t* rgbaTable) {
+    if (!running_.load(std::memory_order_relaxed)) return false;
+    if (frame.getWidth() != width_ || frame.getHeight() != height_) return false;
+
+    uint32_t frameNumber = frameNumber_++;
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t next = (head + 1) % slots_.size();
+    if (next == tail_.load(std::memory_order_acquire)) {
+        droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+        return false;  // Encoder is behind, never wait for it
+    }
+
+    Slot& slot = slots_[head];
+    std::memcpy(slot.pixels.data(), frame.getPixels(), slot.pixels.size());
+    std::copy(rgbaTable, rgbaTable + slot.colors.size(), slot.colors.begin());
+    slot.frameNumber = frameNumber;
+
+    head_.store(next, std::memory_order_release);
+    capturedFrames_.fetch_add(1, std::memory_order_relaxed);
+    wake_.notify_one();
+    return true;
+}
+
+std::string FrameCapture::ffmpegCommand(const std::string& outputFile, int fps) {
+    return "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgb24 -s 256x224 -r " + std::to_string(fps) +
+           " -i - -vf scale=iw*3:ih*3:flags=neighbor -pix_fmt yuv420p \"" + outputFile + "\"";
+}
+
+void FrameCapture::encoderLoop() {
+    for (;;) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            if (!running_.load()) break;  // Stopped and drained
+
+            // The producer never takes the mutex, so wake up periodically
+            // in case a notification is missed
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(5));
+            continue;
+        }
+
+        encode(slots_[tail]);
+        tail_.store((tail + 1) % slots_.size(), std::memory_order_release);
+    }
+}
+
+void FrameCapture::encode(const Slot& slot) {
+    bool written = settings_.format == CaptureFormat::RAW_PIPE ? writeRaw(slot) : writePng(slot);
+    if (written) writtenFrames_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FrameCapture::writeRaw(const Slot& slot) {
+    if (!pipe_) return false;
+
+    rgbBuffer_.resize(slot.pixels.size() * 3);
+    uint8_t* out = rgbBuffer_.data();
+    for (uint8_t index : slot.pixels) {
+        uint32_t color = slot.colors[index & 0x3F];
+        *out++ = static_cast<uint8_t>(color >> 24);
+        *out++ = static_cast<uint8_t>(color >> 16);
+        *out++ = static_cast<uint8_t>(color >> 8);
+    }
+    return std::fwrite(rgbBuffer_.data(), 1, rgbBuffer_.size(), pipe_) == rgbBuffer_.size();
+}
+
+bool FrameCapture::writePng(const Slot& slot) {
+    // 8-bit palette PNG; the pixel data is small enough to store uncompressed
+    std::vector<uint8_t>& png = pngBuffer_;
+    png.assign({0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'});
+
+    std::vector<uint8_t> chunk = {'I', 'H', 'D', 'R'};
+    putBigEndian(chunk, static_cast<uint32_t>(width_));
+    putBigEndian(chunk, static_cast<uint32_t>(height_));
+    chunk.insert(chunk.end(), {8, 3, 0, 0, 0});  // Depth 8, palette, deflate, no filter, no interlace
+    putChunk(png, chunk);
+
+    chunk.assign({'P', 'L', 'T', 'E'});
+    for (uint32_t color : slot.colors) {
+        chunk.push_back(static_cast<uint8_t>(color >> 24));
+        chunk.push_back(static_cast<uint8_t>(color >> 16));
+        chunk.push_back(static_cast<uint8_t>(color >> 8));
+    }
+    putChunk(png, chunk);
+
+    // Rows with filter type 0, wrapped in zlib stored blocks
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(width_ + 1) * height_);
+    for (int y = 0; y < height_; ++y) {
+        raw.push_back(0);
+        const uint8_t* row = slot.pixels.data() + y * width_;
+        for (int x = 0; x < width_; ++x) {
+            raw.push_back(row[x] & 0x3F);  // The palette has 64 entries
+        }
+    }
+
+    chunk.assign({'I', 'D', 'A', 'T', 0x78, 0x01});
+    for (size_t offset = 0; offset < raw.size(); offset += DEFLATE_BLOCK_SIZE) {
+        size_t length = std::min(DEFLATE_BLOCK_SIZE, raw.size() - offset);
+        chunk.push_back(offset + length == raw.size() ? 1 : 0);
+        chunk.push_back(static_cast<uint8_t>(length));
+        chunk.push_back(static_cast<uint8_t>(length >> 8));
+        chunk.push_back(static_cast<uint8_t>(~length));
+        chunk.push_back(static_cast<uint8_t>(~length >> 8));
+        chunk.insert(chunk.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    uint32_t a = 1, b = 0;
+    for (uint8_t value : raw) {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBigEndian(chunk, (b << 16) | a);
+    putChunk(png, chunk);
+
+    chunk.assign({'I', 'E', 'N', 'D'});
+    putChunk(png, chunk);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/frame_%06u.png", slot.frameNumber);
+    return FileUtils::writeBinaryFile(settings_.target + name, png);
+}
+
+} // namespace BattleCity
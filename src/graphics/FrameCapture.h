@@ -0,0 +1,95 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BattleCity {
+
+enum class CaptureFormat {
+    RAW_PIPE,      // RGB24 frames written to a command's stdin (e.g. ffmpeg)
+    PNG_SEQUENCE   // One palette PNG per frame in a directory
+};
+
+struct CaptureSettings {
+    CaptureFormat format = CaptureFormat::RAW_PIPE;
+    std::string target;    // Command for RAW_PIPE, output directory for PNG_SEQUENCE
+    int ringFrames = 16;   // Frames buffered before new ones are dropped
+};
+
+// Records finished frames without stalling the render loop. present() copies
+// the indexed frame (57 KB) and its 64-entry color table into a single
+// producer / single consumer ring; a background thread converts and writes
+// them. When the encoder falls behind the ring fills up and frames are
+// dropped (and counted) instead of blocking the game.
+class FrameCapture {
+public:
+    using ColorTable = std::array<uint32_t, 64>;  // RGBA8888
+
+private:
+    struct Slot {
+        std::vector<uint8_t> pixels;
+        ColorTable colors;
+        uint32_t frameNumber;
+    };
+
+    CaptureSettings settings_;
+    int width_;
+    int height_;
+    std::vector<Slot> slots_;
+    std::atomic<uint32_t> head_;   // Next slot to write (render thread only)
+    std::atomic<uint32_t> tail_;   // Next slot to encode (encoder thread only)
+    std::atomic<bool> running_;
+    std::atomic<uint32_t> capturedFrames_;
+    std::atomic<uint32_t> droppedFrames_;
+    std::atomic<uint32_t> writtenFrames_;
+    uint32_t frameNumber_;
+
+    std::thread encoder_;
+    std::mutex wakeMutex_;                 // Only used to sleep the encoder
+    std::condition_variable wake_;
+
+    FILE* pipe_;
+    std::vector<uint8_t> rgbBuffer_;       // Encoder-side scratch
+    std::vector<uint8_t> pngBuffer_;
+
+public:
+    FrameCapture(int width, int height);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Open the output and start the encoder thread
+    bool start(const CaptureSettings& settings);
+
+    // Flush the frames still queued, close the output
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    // Render thread: queue a finished frame; never blocks
+    bool submit(const IndexedSurface& frame, const uint32_t* rgbaTable);
+
+    uint32_t getCapturedFrames() const { return capturedFrames_.load(std::memory_order_relaxed); }
+    uint32_t getDroppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+    uint32_t getWrittenFrames() const { return writtenFrames_.load(std::memory_order_relaxed); }
+
+    // ffmpeg command that encodes the raw stream into a video file
+    static std::string ffmpegCommand(const std::string& outputFile, int fps = 60);
+
+private:
+    void encoderLoop();
+    void encode(const Slot& slot);
+    bool writeRaw(const Slot& slot);
+    bool writePng(const Slot& slot);
+};
+
+} // namespace BattleCity
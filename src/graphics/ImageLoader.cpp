@@ -0,0 +1,73 @@
+#include "ImageLoader.h"
+#include "Palette.h"
+#include "../utils/FileUtils.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_NO_STDIO
+// PNG-only builds leave some of stb_image's helpers unused
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "../third_party/stb_image.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace BattleCity {
+
+ImageLoader::ImageLoader(const Palette& palette) : palette_(palette) {
+}
+
+bool ImageLoader::loadPng(const std::string& path, IndexedSurface& image) {
+    std::vector<uint8_t> fileData = FileUtils::readBinaryFile(path);
+    if (fileData.empty()) return false;
+    return decodePng(fileData.data(), fileData.size(), image);
+}
+
+bool ImageLoader::decodePng(const uint8_t* data, size_t size, IndexedSurface& image) {
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* rgba = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 4);
+    if (!rgba) return false;
+
+    image.resize(width, height);
+    for (int y = 0; y < height; ++y) {
+        const stbi_uc* src = rgba + static_cast<size_t>(y) * width * 4;
+        uint8_t* dst = image.getRow(y);
+        for (int x = 0; x < width; ++x) {
+            dst[x] = quantize(src[x * 4], src[x * 4 + 1], src[x * 4 + 2], src[x * 4 + 3]);
+        }
+    }
+
+    stbi_image_free(rgba);
+    return true;
+}
+
+uint8_t ImageLoader::quantize(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (a < 128) return 0;
+
+    uint32_t key = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+    auto cached = colorCache_.find(key);
+    if (cached != colorCache_.end()) return cached->second;
+
+    // Index 0 is reserved as the transparent key, so search 1..63
+    uint8_t bestIndex = 1;
+    int bestDistance = 0x7FFFFFFF;
+    for (size_t i = 1; i < palette_.size(); ++i) {
+        const SDL_Color& color = palette_.getColor(static_cast<uint8_t>(i));
+        int dr = static_cast<int>(r) - color.r;
+        int dg = static_cast<int>(g) - color.g;
+        int db = static_cast<int>(b) - color.b;
+        int distance = dr * dr + dg * dg + db * db;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = static_cast<uint8_t>(i);
+        }
+    }
+
+    colorCache_[key] = bestIndex;
+    return bestIndex;
+}
+
+} // namespace BattleCity
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace BattleCity {
+
+class Palette;
+
+// Decodes PNG files (via the bundled stb_image) and converts them to NES
+// palette indices. Pixels with alpha < 128 become index 0 (transparent), so
+// opaque pixels are always mapped to a non-zero index.
+class ImageLoader {
+private:
+    const Palette& palette_;
+    std::unordered_map<uint32_t, uint8_t> colorCache_;  // RGB -> palette index
+
+public:
+    explicit ImageLoader(const Palette& palette);
+
+    bool loadPng(const std::string& path, IndexedSurface& image);
+    bool decodePng(const uint8_t* data, size_t size, IndexedSurface& image);
+
+    // Nearest NES palette index for an RGBA color (0 = transparent)
+    uint8_t quantize(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+};
+
+} // namespace BattleCity
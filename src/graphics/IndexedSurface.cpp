@@ -0,0 +1,168 @@
+#include "IndexedSurface.h"
+#include <cstring>
+
+namespace BattleCity {
+
+IndexedSurface::IndexedSurface() : width_(0), height_(0), data_(pixels_.data()) {
+}
+
+IndexedSurface::IndexedSurface(int width, int height, uint8_t fillIndex)
+    : width_(0), height_(0), data_(nullptr) {
+    resize(width, height, fillIndex);
+}
+
+IndexedSurface::IndexedSurface(const IndexedSurface& other)
+    : width_(other.width_), height_(other.height_), pixels_(other.pixels_) {
+    data_ = other.isView() ? other.data_ : pixels_.data();
+}
+
+IndexedSurface::IndexedSurface(IndexedSurface&& other) noexcept
+    : width_(other.width_), height_(other.height_) {
+    bool otherIsView = other.isView();
+    pixels_ = std::move(other.pixels_);
+    data_ = otherIsView ? other.data_ : pixels_.data();
+    other.width_ = other.height_ = 0;
+    other.pixels_.clear();
+    other.data_ = other.pixels_.data();
+}
+
+IndexedSurface& IndexedSurface::operator=(const IndexedSurface& other) {
+    if (this != &other) {
+        width_ = other.width_;
+        height_ = other.height_;
+        pixels_ = other.pixels_;
+        data_ = other.isView() ? other.data_ : pixels_.data();
+    }
+    return *this;
+}
+
+IndexedSurface& IndexedSurface::operator=(IndexedSurface&& other) noexcept {
+    if (this != &other) {
+        bool otherIsView = other.isView();
+        width_ = other.width_;
+        height_ = other.height_;
+        pixels_ = std::move(other.pixels_);
+        data_ = otherIsView ? other.data_ : pixels_.data();
+        other.width_ = other.height_ = 0;
+        other.pixels_.clear();
+        other.data_ = other.pixels_.data();
+    }
+    return *this;
+}
+
+IndexedSurface IndexedSurface::view(const uint8_t* pixels, int width, int height) {
+    IndexedSurface surface;
+    surface.width_ = std::max(0, width);
+    surface.height_ = std::max(0, height);
+    surface.data_ = const_cast<uint8_t*>(pixels);
+    return surface;
+}
+
+void IndexedSurface::resize(int width, int height, uint8_t fillIndex) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    pixels_.assign(static_cast<size_t>(width_) * height_, fillIndex);
+    data_ = pixels_.data();
+}
+
+void IndexedSurface::setPixel(int x, int y, uint8_t colorIndex) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+    data_[y * width_ + x] = colorIndex;
+}
+
+uint8_t IndexedSurface::getPixel(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return 0;
+    return data_[y * width_ + x];
+}
+
+void IndexedSurface::clear(uint8_t colorIndex) {
+    if (!data_) return;
+    std::memset(data_, colorIndex, static_cast<size_t>(width_) * height_);
+}
+
+void IndexedSurface::fillRect(int x, int y, int w, int h, uint8_t colorIndex) {
+    Rect dest(x, y, w, h);
+    int unusedX = 0, unusedY = 0;
+    if (!clip(dest, unusedX, unusedY)) return;
+
+    for (int row = dest.y; row < dest.y + dest.h; ++row) {
+        std::memset(getRow(row) + dest.x, colorIndex, dest.w);
+    }
+}
+
+void IndexedSurface::drawRect(int x, int y, int w, int h, uint8_t colorIndex) {
+    if (w <= 0 || h <= 0) return;
+
+    // Same outline as SDL_RenderDrawRect: top/bottom rows and left/right columns
+    fillRect(x, y, w, 1, colorIndex);
+    fillRect(x, y + h - 1, w, 1, colorIndex);
+    fillRect(x, y, 1, h, colorIndex);
+    fillRect(x + w - 1, y, 1, h, colorIndex);
+}
+
+void IndexedSurface::blit(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY) {
+    Rect dest;
+    int sourceX = 0, sourceY = 0;
+    if (!clipBlit(source, sourceRect, destX, destY, dest, sourceX, sourceY)) return;
+
+    for (int row = 0; row < dest.h; ++row) {
+        std::memcpy(getRow(dest.y + row) + dest.x,
+                    source.getRow(sourceY + row) + sourceX,
+                    dest.w);
+    }
+}
+
+void IndexedSurface::blitTransparent(const IndexedSurface& source, const Rect& sourceRect,
+                                     int destX, int destY) {
+    Rect dest;
+    int sourceX = 0, sourceY = 0;
+    if (!clipBlit(source, sourceRect, destX, destY, dest, sourceX, sourceY)) return;
+
+    for (int row = 0; row < dest.h; ++row) {
+        uint8_t* dst = getRow(dest.y + row) + dest.x;
+        const uint8_t* src = source.getRow(sourceY + row) + sourceX;
+        for (int x = 0; x < dest.w; ++x) {
+            if (src[x] != 0) dst[x] = src[x];
+        }
+    }
+}
+
+void IndexedSurface::blitRemapped(const IndexedSurface& source, const Rect& sourceRect,
+                                  int destX, int destY, const uint8_t* remap) {
+    Rect dest;
+    int sourceX = 0, sourceY = 0;
+    if (!clipBlit(source, sourceRect, destX, destY, dest, sourceX, sourceY)) return;
+
+    for (int row = 0; row < dest.h; ++row) {
+        uint8_t* dst = getRow(dest.y + row) + dest.x;
+        const uint8_t* src = source.getRow(sourceY + row) + sourceX;
+        for (int x = 0; x < dest.w; ++x) {
+            if (src[x] != 0) dst[x] = remap[src[x] & 0x3F];
+        }
+    }
+}
+
+bool IndexedSurface::clipBlit(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY,
+                              Rect& dest, int& sourceX, int& sourceY) const {
+    // Clip the source rectangle against the source surface first
+    Rect src = sourceRect;
+    if (src.x < 0) { destX -= src.x; src.w += src.x; src.x = 0; }
+    if (src.y < 0) { destY -= src.y; src.h += src.y; src.y = 0; }
+    src.w = std::min(src.w, source.width_ - src.x);
+    src.h = std::min(src.h, source.height_ - src.y);
+
+    dest = Rect(destX, destY, src.w, src.h);
+    sourceX = src.x;
+    sourceY = src.y;
+    return clip(dest, sourceX, sourceY);
+}
+
+bool IndexedSurface::clip(Rect& dest, int& sourceX, int& sourceY) const {
+    if (dest.x < 0) { sourceX -= dest.x; dest.w += dest.x; dest.x = 0; }
+    if (dest.y < 0) { sourceY -= dest.y; dest.h += dest.y; dest.y = 0; }
+    if (dest.x + dest.w > width_) dest.w = width_ - dest.x;
+    if (dest.y + dest.h > height_) dest.h = height_ - dest.y;
+    return dest.w > 0 && dest.h > 0;
+}
+
+} // namespace BattleCity
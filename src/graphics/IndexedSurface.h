@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../utils/MathUtils.h"
+#include <cstdint>
+#include <vector>
+
+namespace BattleCity {
+
+// 8-bit surface holding NES palette indices (one byte per pixel).
+// Used for the frame buffer and for cached layers that are blitted into it.
+class IndexedSurface {
+private:
+    int width_;
+    int height_;
+    std::vector<uint8_t> pixels_;
+    uint8_t* data_;  // pixels_.data(), or external memory for views
+
+public:
+    IndexedSurface();
+    IndexedSurface(int width, int height, uint8_t fillIndex = 0);
+    IndexedSurface(const IndexedSurface& other);
+    IndexedSurface(IndexedSurface&& other) noexcept;
+    IndexedSurface& operator=(const IndexedSurface& other);
+    IndexedSurface& operator=(IndexedSurface&& other) noexcept;
+
+    // Read-only view over pixels owned elsewhere (e.g. a mapped asset pack).
+    // The memory must outlive the view and must not be drawn into; resize()
+    // turns a view back into an owning surface.
+    static IndexedSurface view(const uint8_t* pixels, int width, int height);
+    bool isView() const { return data_ != pixels_.data(); }
+
+    void resize(int width, int height, uint8_t fillIndex = 0);
+
+    // Pixel access
+    uint8_t* getPixels() { return data_; }
+    const uint8_t* getPixels() const { return data_; }
+    uint8_t* getRow(int y) { return data_ + y * width_; }
+    const uint8_t* getRow(int y) const { return data_ + y * width_; }
+
+    void setPixel(int x, int y, uint8_t colorIndex);
+    uint8_t getPixel(int x, int y) const;
+
+    // Drawing (all operations clip against the surface bounds)
+    void clear(uint8_t colorIndex);
+    void fillRect(int x, int y, int w, int h, uint8_t colorIndex);
+    void drawRect(int x, int y, int w, int h, uint8_t colorIndex);
+
+    // Opaque copy of a region of another surface
+    void blit(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY);
+
+    // Copy that skips index 0 (transparent sprite pixels)
+    void blitTransparent(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY);
+
+    // Transparent copy with every index mapped through remap[64]
+    void blitRemapped(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY,
+                      const uint8_t* remap);
+
+    // Getters
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getPitch() const { return width_; }
+    Rect getBounds() const { return Rect(0, 0, width_, height_); }
+
+    // Clip a destination rectangle (and the matching source offset) to the surface
+    bool clip(Rect& dest, int& sourceX, int& sourceY) const;
+
+private:
+    bool clipBlit(const IndexedSurface& source, const Rect& sourceRect, int destX, int destY,
+                  Rect& dest, int& sourceX, int& sourceY) const;
+};
+
+} // namespace BattleCity
@@ -115,7 +115,10 @@ public:
     static constexpr uint8_t COLOR_YELLOW = 0x28;   // Brick wall / Menu selection
     static constexpr uint8_t COLOR_GRAY = 0x00;     // Basic enemy
     static constexpr uint8_t COLOR_GREEN = 0x0A;    // Grass
-    static constexpr uint8_t COLOR_CYAN = 0x1C;     // Water
+    static constexpr uint8_t COLOR_CYAN = 0x1C;     // Shield, power-ups
+    static constexpr uint8_t COLOR_WATER = 0x12;    // Water (cycled with the highlight)
+    static constexpr uint8_t COLOR_WATER_HIGHLIGHT = 0x3C;
+    static constexpr uint8_t COLOR_FOREST = 0x1A;   // Forest canopy
     static constexpr uint8_t COLOR_ORANGE = 0x16;   // Explosions
     static constexpr uint8_t COLOR_PINK = 0x24;     // Timer bomb
 };
@@ -0,0 +1,85 @@
+#include "PaletteEffects.h"
+#include "Palette.h"
+#include <algorithm>
+
+namespace BattleCity {
+
+namespace {
+
+constexpr uint8_t NES_BLACK = 0x0F;
+constexpr uint8_t NES_WHITE = 0x30;
+
+// Colors rotated by the water shimmer (the water art only uses these)
+constexpr uint8_t WATER_CYCLE[] = {
+    BattleCityPalette::COLOR_WATER,
+    BattleCityPalette::COLOR_WATER_HIGHLIGHT
+};
+constexpr int WATER_CYCLE_LENGTH = sizeof(WATER_CYCLE) / sizeof(WATER_CYCLE[0]);
+
+} // namespace
+
+PaletteEffects::PaletteEffects() : brightness_(0), flash_(false), cyclePhase_(0), changed_(true) {
+}
+
+void PaletteEffects::setBrightness(int steps) {
+    steps = std::max(-MAX_BRIGHTNESS_STEPS, std::min(MAX_BRIGHTNESS_STEPS, steps));
+    if (steps == brightness_) return;
+    brightness_ = steps;
+    changed_ = true;
+}
+
+void PaletteEffects::setFlash(bool enabled) {
+    if (enabled == flash_) return;
+    flash_ = enabled;
+    changed_ = true;
+}
+
+void PaletteEffects::reset() {
+    setBrightness(0);
+    setFlash(false);
+}
+
+void PaletteEffects::setCyclePhase(int phase) {
+    phase %= WATER_CYCLE_LENGTH;
+    if (phase == cyclePhase_) return;
+    cyclePhase_ = phase;
+    changed_ = true;
+}
+
+bool PaletteEffects::consumeChanged() {
+    bool changed = changed_;
+    changed_ = false;
+    return changed;
+}
+
+void PaletteEffects::buildRemap(Remap& remap) const {
+    for (size_t i = 0; i < remap.size(); ++i) {
+        uint8_t color = static_cast<uint8_t>(i);
+
+        for (int c = 0; c < WATER_CYCLE_LENGTH; ++c) {
+            if (color == WATER_CYCLE[c]) {
+                color = WATER_CYCLE[(c + cyclePhase_) % WATER_CYCLE_LENGTH];
+                break;
+            }
+        }
+
+        remap[i] = flash_ ? NES_WHITE : stepBrightness(color, brightness_);
+    }
+}
+
+uint8_t PaletteEffects::stepBrightness(uint8_t colorIndex, int steps) {
+    int hue = colorIndex & 0x0F;
+    int luma = (colorIndex >> 4) & 0x03;
+
+    // Columns 0x0D-0x0F are blacks (and a gray in 0x2D/0x3D), they only fade out
+    if (hue >= 0x0D) {
+        return steps < 0 ? NES_BLACK : colorIndex;
+    }
+
+    luma += steps;
+    if (luma < 0) return NES_BLACK;
+    if (luma > 3) return NES_WHITE;
+    return static_cast<uint8_t>((luma << 4) | hue);
+}
+
+} // namespace BattleCity
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace BattleCity {
+
+// Screen-wide color effects done the NES way: by remapping palette entries
+// instead of blending pixels. The remap is folded into the index -> RGBA
+// table used when the frame is converted for upload, so fades, flashes and
+// color cycling cost nothing per pixel; only the 64-entry table is rebuilt
+// when an effect changes.
+class PaletteEffects {
+public:
+    static constexpr int MAX_BRIGHTNESS_STEPS = 4;  // -4 = black, +4 = white
+    using Remap = std::array<uint8_t, 64>;
+
+private:
+    int brightness_;   // NES luminance steps, 0 = unchanged
+    bool flash_;       // Everything drawn white
+    int cyclePhase_;   // Water shimmer phase
+    bool changed_;
+
+public:
+    PaletteEffects();
+
+    // Per-frame effects (cleared by reset())
+    void setBrightness(int steps);
+    void setFlash(bool enabled);
+    void reset();
+
+    // Persistent effects
+    void setCyclePhase(int phase);
+
+    int getBrightness() const { return brightness_; }
+    bool isFlashing() const { return flash_; }
+
+    // True once after any effect changed; the caller rebuilds its table then
+    bool consumeChanged();
+
+    // Current index -> index remap
+    void buildRemap(Remap& remap) const;
+
+    // Move a color up (positive) or down (negative) the NES luminance rows.
+    // Darkest colors fall to black and the brightest ones saturate to white.
+    static uint8_t stepBrightness(uint8_t colorIndex, int steps);
+};
+
+} // namespace BattleCity
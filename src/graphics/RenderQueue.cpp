@@ -0,0 +1,109 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cstring>
+
+namespace BattleCity {
+
+RenderQueue::RenderQueue() : sequence_(0) {
+    commands_.reserve(256);
+    textBuffer_.reserve(256);
+    for (PaletteRemap& remap : palettes_) {
+        for (size_t i = 0; i < remap.size(); ++i) {
+            remap[i] = static_cast<uint8_t>(i);
+        }
+    }
+}
+
+void RenderQueue::addSprite(RenderLayer layer, SpriteId sprite, int x, int y, uint8_t palette) {
+    if (sprite == INVALID_SPRITE) return;
+    RenderCommand& command = push(layer, RenderCommandType::ATLAS_SPRITE, x, y);
+    command.sprite = sprite;
+    command.palette = palette % MAX_PALETTES;
+}
+
+void RenderQueue::addPattern(RenderLayer layer, const uint8_t* pattern, int x, int y, int size) {
+    if (!pattern) return;
+    RenderCommand& command = push(layer, RenderCommandType::PATTERN, x, y);
+    command.pattern = pattern;
+    command.w = static_cast<int16_t>(size);
+    command.h = static_cast<int16_t>(size);
+}
+
+void RenderQueue::addPattern(RenderLayer layer, const uint8_t* pattern, int x, int y, int size, uint8_t color) {
+    if (!pattern) return;
+    addPattern(layer, pattern, x, y, size);
+    commands_.back().solid = true;
+    commands_.back().color = color;
+}
+
+void RenderQueue::addFillRect(RenderLayer layer, int x, int y, int w, int h, uint8_t color) {
+    RenderCommand& command = push(layer, RenderCommandType::FILL_RECT, x, y);
+    command.w = static_cast<int16_t>(w);
+    command.h = static_cast<int16_t>(h);
+    command.color = color;
+}
+
+void RenderQueue::addOutlineRect(RenderLayer layer, int x, int y, int w, int h, uint8_t color) {
+    RenderCommand& command = push(layer, RenderCommandType::OUTLINE_RECT, x, y);
+    command.w = static_cast<int16_t>(w);
+    command.h = static_cast<int16_t>(h);
+    command.color = color;
+}
+
+void RenderQueue::addText(RenderLayer layer, int x, int y, const char* text, uint8_t color) {
+    if (!text) return;
+    size_t length = std::strlen(text);
+
+    // Strings are copied into one buffer so callers may pass temporaries
+    RenderCommand& command = push(layer, RenderCommandType::TEXT, x, y);
+    command.textOffset = static_cast<uint32_t>(textBuffer_.size());
+    command.textLength = static_cast<uint16_t>(length);
+    command.color = color;
+    textBuffer_.append(text, length);
+    textBuffer_.push_back('\0');
+}
+
+void RenderQueue::addSurface(RenderLayer layer, const IndexedSurface* surface, int x, int y) {
+    if (!surface) return;
+    RenderCommand& command = push(layer, RenderCommandType::SURFACE, x, y);
+    command.surface = surface;
+}
+
+void RenderQueue::addSpans(RenderLayer layer, const SpanSprite* spans, int x, int y, uint8_t palette) {
+    if (!spans || spans->getSpanCount() == 0) return;
+    RenderCommand& command = push(layer, RenderCommandType::SPANS, x, y);
+    command.spans = spans;
+    command.palette = palette % MAX_PALETTES;
+}
+
+void RenderQueue::sort() {
+    std::sort(commands_.begin(), commands_.end(),
+              [](const RenderCommand& a, const RenderCommand& b) { return a.sortKey < b.sortKey; });
+}
+
+void RenderQueue::clear() {
+    commands_.clear();
+    textBuffer_.clear();
+    sequence_ = 0;
+}
+
+void RenderQueue::setPalette(uint8_t palette, const PaletteRemap& remap) {
+    if (palette == 0 || palette >= MAX_PALETTES) return;
+    palettes_[palette] = remap;
+}
+
+RenderCommand& RenderQueue::push(RenderLayer layer, RenderCommandType type, int x, int y) {
+    RenderCommand command = {};
+    // Key: layer (8 bits) | source (8 bits) | submission order (32 bits)
+    command.sortKey = (static_cast<uint64_t>(layer) << 40) |
+                      (static_cast<uint64_t>(type) << 32) |
+                      sequence_++;
+    command.type = type;
+    command.x = static_cast<int16_t>(x);
+    command.y = static_cast<int16_t>(y);
+    command.sprite = INVALID_SPRITE;
+    commands_.push_back(command);
+    return commands_.back();
+}
+
+} // namespace BattleCity
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SpriteAtlas.h"
+#include "SpanSprite.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BattleCity {
+
+// Draw order of queued commands (lowest first)
+enum class RenderLayer : uint8_t {
+    GROUND,     // Cached floor and walls, objects on the ground (base)
+    WATER,      // Cached water overlay
+    ENTITIES,   // Tanks and power-ups
+    BULLETS,
+    CANOPY,     // Cached forest overlay, hides tanks and bullets
+    EFFECTS,    // Shields, explosions
+    HUD,
+    COUNT
+};
+
+// Source of a command's pixels; commands with the same source are batched
+enum class RenderCommandType : uint8_t {
+    ATLAS_SPRITE,  // Sprite from the atlas surface
+    PATTERN,       // Square placeholder sprite (0 = transparent)
+    FILL_RECT,
+    OUTLINE_RECT,
+    TEXT,
+    SURFACE,       // Opaque cached layer
+    SPANS          // Cached transparent layer (span mask)
+};
+
+struct RenderCommand {
+    uint64_t sortKey;         // Layer, source, submission order
+    RenderCommandType type;
+    uint8_t color;            // Fill/outline/text/pattern color
+    bool solid;               // PATTERN: opaque bytes drawn in color instead of their own
+    uint8_t palette;          // Remap table for sprites (0 = unchanged)
+    int16_t x, y;
+    int16_t w, h;             // Rect/pattern size
+    SpriteId sprite;          // ATLAS_SPRITE
+    uint32_t textOffset;      // TEXT: start of the string in the text buffer
+    uint16_t textLength;
+    const uint8_t* pattern;   // PATTERN data, must stay valid until the flush
+    const IndexedSurface* surface;  // SURFACE source, same lifetime rule
+    const SpanSprite* spans;        // SPANS source, same lifetime rule
+};
+
+// Per-frame list of draw commands. Gameplay and HUD code enqueue during
+// Game::render; the renderer sorts the list by layer and source once and
+// rasterizes it in a single pass, so the frame still ends in one texture
+// upload and one copy regardless of the number of entities.
+class RenderQueue {
+public:
+    static constexpr int MAX_PALETTES = 8;
+    using PaletteRemap = std::array<uint8_t, 64>;
+
+private:
+    std::vector<RenderCommand> commands_;
+    std::string textBuffer_;  // Text of TEXT commands, reused between frames
+    uint32_t sequence_;
+    std::array<PaletteRemap, MAX_PALETTES> palettes_;
+
+public:
+    RenderQueue();
+
+    // Enqueue
+    void addSprite(RenderLayer layer, SpriteId sprite, int x, int y, uint8_t palette = 0);
+    void addPattern(RenderLayer layer, const uint8_t* pattern, int x, int y, int size);
+    void addPattern(RenderLayer layer, const uint8_t* pattern, int x, int y, int size, uint8_t color);
+    void addFillRect(RenderLayer layer, int x, int y, int w, int h, uint8_t color);
+    void addOutlineRect(RenderLayer layer, int x, int y, int w, int h, uint8_t color);
+    void addText(RenderLayer layer, int x, int y, const char* text, uint8_t color);
+    void addSurface(RenderLayer layer, const IndexedSurface* surface, int x, int y);
+    void addSpans(RenderLayer layer, const SpanSprite* spans, int x, int y, uint8_t palette = 0);
+
+    // Sort into submission order (stable within a layer and source)
+    void sort();
+    void clear();
+
+    const std::vector<RenderCommand>& getCommands() const { return commands_; }
+    const char* getText(const RenderCommand& command) const { return textBuffer_.data() + command.textOffset; }
+    bool isEmpty() const { return commands_.empty(); }
+
+    // Sprite palette remaps (palette 0 is the identity and cannot be changed)
+    void setPalette(uint8_t palette, const PaletteRemap& remap);
+    const PaletteRemap& getPalette(uint8_t palette) const { return palettes_[palette % MAX_PALETTES]; }
+
+private:
+    RenderCommand& push(RenderLayer layer, RenderCommandType type, int x, int y);
+};
+
+} // namespace BattleCity
@@ -1,18 +1,34 @@
 #include "Renderer.h"
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 #include <iostream>
 
 namespace BattleCity {
 
+namespace {
+
+double elapsedMilliseconds(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+} // namespace
+
 Renderer::Renderer(int scaleFactor, bool vsync)
-    : window_(nullptr), renderer_(nullptr), gameTexture_(nullptr),
-      scaleFactor_(scaleFactor), vsyncEnabled_(vsync) {
+    : window_(nullptr), renderer_(nullptr), currentTexture_(0),
+      frameBuffer_(GAME_WIDTH, GAME_HEIGHT, BattleCityPalette::COLOR_BLACK),
+      cameraX_(0), cameraY_(0), scanlineMode_(false), scaleFactor_(scaleFactor), vsyncEnabled_(vsync) {
+    gameTextures_.fill(nullptr);
     palette_ = std::make_unique<Palette>();
+    buildRgbaTable();
 }
 
 Renderer::~Renderer() {
-    if (gameTexture_) SDL_DestroyTexture(gameTexture_);
+    stopCapture();
+    softwarePresenter_.reset();
+    for (SDL_Texture* texture : gameTextures_) {
+        if (texture) SDL_DestroyTexture(texture);
+    }
     if (renderer_) SDL_DestroyRenderer(renderer_);
     if (window_) SDL_DestroyWindow(window_);
     SDL_Quit();
@@ -38,13 +54,35 @@ bool Renderer::init() {
         renderFlags |= SDL_RENDERER_PRESENTVSYNC;
     }
     renderer_ = SDL_CreateRenderer(window_, -1, renderFlags);
-    if (!renderer_) return false;
+    SDL_RendererInfo info;
+    if (renderer_ && SDL_GetRendererInfo(renderer_, &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE)) {
+        SDL_DestroyRenderer(renderer_);
+        renderer_ = nullptr;
+    }
 
-    // Create game texture (256x224)
-    gameTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888,
-                                   SDL_TEXTUREACCESS_STREAMING,
-                                   GAME_WIDTH, GAME_HEIGHT);
-    if (!gameTexture_) return false;
+    if (!renderer_) {
+        // No GPU: scale in software straight into the window surface
+        softwarePresenter_ = std::make_unique<SoftwarePresenter>(GAME_WIDTH, GAME_HEIGHT);
+        if (softwarePresenter_->init(window_)) {
+            softwarePresenter_->setColors(rgbaTable_.data());
+            std::cout << "No accelerated renderer, using the software presenter ("
+                      << softwarePresenter_->getScale() << "x)" << std::endl;
+            return true;
+        }
+        softwarePresenter_.reset();
+
+        // Last resort: SDL's own software renderer
+        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_SOFTWARE);
+        if (!renderer_) return false;
+    }
+
+    // Create the game textures (256x224)
+    for (SDL_Texture*& texture : gameTextures_) {
+        texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_STREAMING,
+                                    GAME_WIDTH, GAME_HEIGHT);
+        if (!texture) return false;
+    }
 
     // Set logical size for pixel-perfect rendering
     SDL_RenderSetLogicalSize(renderer_, GAME_WIDTH, GAME_HEIGHT);
@@ -52,80 +90,232 @@ bool Renderer::init() {
     return true;
 }
 
+bool Renderer::loadSprites(const std::string& spriteRoot) {
+    return atlas_.load(spriteRoot, *palette_);
+}
+
 void Renderer::clear() {
-    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
-    SDL_RenderClear(renderer_);
+    if (scanlineMode_) {
+        frameBuffer_.clear(ScanlineRenderer::OVERLAY_CLEAR);  // Transparent over the scanline output
+        scanline_.beginFrame();
+    } else {
+        frameBuffer_.clear(BattleCityPalette::COLOR_BLACK);
+    }
+    queue_.clear();
+    effects_.reset();
 }
 
 void Renderer::present() {
-    updateGameTexture();
+    flushQueue();
+    applyPaletteEffects();
+    if (!scanlineMode_) captureFrame(frameBuffer_);
+    if (softwarePresenter_) {
+        presentSoftware();
+        return;
+    }
+
+    // Fill the next texture in the rotation; the two before it may still be
+    // in flight on the GPU
+    currentTexture_ = (currentTexture_ + 1) % TEXTURE_COUNT;
+    timings_.lock = 0.0;
+    timings_.upload = 0.0;
+    if (scanlineMode_) {
+        renderScanlines();
+    } else {
+        updateGameTexture();
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
     renderScaled();
     SDL_RenderPresent(renderer_);
+    timings_.present = elapsedMilliseconds(start);
+    timings_.peakPresent = std::max(timings_.peakPresent, timings_.present);
+    ++timings_.frames;
 }
 
 void Renderer::setPixel(int x, int y, uint8_t colorIndex) {
-    if (x < 0 || x >= GAME_WIDTH || y < 0 || y >= GAME_HEIGHT) return;
-
-    // Get NES color
-    const SDL_Color& color = palette_->getColor(colorIndex);
-
-    // Set render color
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-
-    // Draw pixel
-    SDL_RenderDrawPoint(renderer_, x, y);
+    frameBuffer_.setPixel(x, y, colorIndex);
 }
 
 uint8_t Renderer::getPixel(int x, int y) const {
-    // This would require reading back from the texture, which is expensive
-    // For now, return 0 (black)
-    return 0;
+    return frameBuffer_.getPixel(x, y);
 }
 
 void Renderer::fillRect(int x, int y, int w, int h, uint8_t colorIndex) {
-    const SDL_Color& color = palette_->getColor(colorIndex);
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderFillRect(renderer_, &rect);
+    frameBuffer_.fillRect(x, y, w, h, colorIndex);
 }
 
 void Renderer::drawRect(int x, int y, int w, int h, uint8_t colorIndex) {
-    const SDL_Color& color = palette_->getColor(colorIndex);
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    frameBuffer_.drawRect(x, y, w, h, colorIndex);
+}
 
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderDrawRect(renderer_, &rect);
+void Renderer::blit(const IndexedSurface& surface, int x, int y) {
+    frameBuffer_.blit(surface, surface.getBounds(), x, y);
+}
+
+void Renderer::blit(const IndexedSurface& surface, const Rect& sourceRect, int x, int y) {
+    frameBuffer_.blit(surface, sourceRect, x, y);
 }
 
 void Renderer::drawSprite(int x, int y, const uint8_t* spriteData, uint8_t colorIndex) {
-    for (int sy = 0; sy < 8; ++sy) {
-        for (int sx = 0; sx < 8; ++sx) {
-            uint8_t pixel = spriteData[sy * 8 + sx];
-            if (pixel != 0) {  // 0 = transparent
-                setPixel(x + sx, y + sy, pixel);
-            }
-        }
-    }
+    if (spriteData == nullptr) return;
+    getPatternSpans(spriteData, 8).draw(frameBuffer_, x, y);  // 0 = transparent
+}
+
+void Renderer::drawAtlasSprite(SpriteId sprite, int x, int y) {
+    if (!atlas_.isValid(sprite)) return;
+    atlas_.getSpans(sprite).draw(frameBuffer_, x, y);
+}
+
+void Renderer::drawAtlasSpriteCentered(SpriteId sprite, int centerX, int centerY) {
+    if (!atlas_.isValid(sprite)) return;
+    const Rect& rect = atlas_.getRect(sprite);
+    atlas_.getSpans(sprite).draw(frameBuffer_, centerX - rect.w / 2, centerY - rect.h / 2);
 }
 
 void Renderer::drawText(int x, int y, const char* text, uint8_t colorIndex) {
-    if (text == nullptr) return;
-    int currentX = x;
-    while (*text) {
-        if (*text >= 32 && *text < 128) {
-            const uint8_t* charData = FONT_DATA[*text - 32];
-            for (int cy = 0; cy < 8; ++cy) {
-                for (int cx = 0; cx < 8; ++cx) {
-                    if (charData[cy] & (1 << (7 - cx))) {
-                        setPixel(currentX + cx, y + cy, colorIndex);
-                    }
-                }
+    BitmapFont::drawText(frameBuffer_, x, y, text, colorIndex);
+}
+
+void Renderer::queueSprite(RenderLayer layer, SpriteId sprite, int x, int y, uint8_t palette) {
+    if (!atlas_.isValid(sprite)) return;
+    const Rect& rect = atlas_.getRect(sprite);
+    if (!toScreen(layer, x, y, rect.w, rect.h)) return;
+    queue_.addSprite(layer, sprite, x, y, palette);
+}
+
+void Renderer::queueSpriteCentered(RenderLayer layer, SpriteId sprite, int centerX, int centerY, uint8_t palette) {
+    if (!atlas_.isValid(sprite)) return;
+    const Rect& rect = atlas_.getRect(sprite);
+    queueSprite(layer, sprite, centerX - rect.w / 2, centerY - rect.h / 2, palette);
+}
+
+void Renderer::queuePattern(RenderLayer layer, int x, int y, const uint8_t* pattern, int size) {
+    if (!toScreen(layer, x, y, size, size)) return;
+    queue_.addPattern(layer, pattern, x, y, size);
+}
+
+void Renderer::queuePattern(RenderLayer layer, int x, int y, const uint8_t* pattern, int size, uint8_t colorIndex) {
+    if (!toScreen(layer, x, y, size, size)) return;
+    queue_.addPattern(layer, pattern, x, y, size, colorIndex);
+}
+
+void Renderer::queueRect(RenderLayer layer, int x, int y, int w, int h, uint8_t colorIndex) {
+    if (!toScreen(layer, x, y, w, h)) return;
+    queue_.addFillRect(layer, x, y, w, h, colorIndex);
+}
+
+void Renderer::queueOutline(RenderLayer layer, int x, int y, int w, int h, uint8_t colorIndex) {
+    if (!toScreen(layer, x, y, w, h)) return;
+    queue_.addOutlineRect(layer, x, y, w, h, colorIndex);
+}
+
+void Renderer::queueText(RenderLayer layer, int x, int y, const char* text, uint8_t colorIndex) {
+    if (!toScreen(layer, x, y, static_cast<int>(strlen(text)) * 8, 8)) return;
+    queue_.addText(layer, x, y, text, colorIndex);
+}
+
+void Renderer::queueSurface(RenderLayer layer, const IndexedSurface& surface, int x, int y) {
+    if (!toScreen(layer, x, y, surface.getWidth(), surface.getHeight())) return;
+    queue_.addSurface(layer, &surface, x, y);
+}
+
+void Renderer::queueSpans(RenderLayer layer, const SpanSprite& spans, int x, int y, uint8_t palette) {
+    if (!toScreen(layer, x, y, spans.getWidth(), spans.getHeight())) return;
+    queue_.addSpans(layer, &spans, x, y, palette);
+}
+
+bool Renderer::toScreen(RenderLayer layer, int& x, int& y, int w, int h) const {
+    if (layer < RenderLayer::HUD) {
+        x -= cameraX_;
+        y -= cameraY_;
+    }
+    return x + w > 0 && y + h > 0 && x < GAME_WIDTH && y < GAME_HEIGHT;
+}
+
+void Renderer::setScanlineMode(bool enabled) {
+    scanlineMode_ = enabled;
+    frameBuffer_.clear(enabled ? ScanlineRenderer::OVERLAY_CLEAR : BattleCityPalette::COLOR_BLACK);
+    scanline_.beginFrame();
+    invalidateTextures();
+}
+
+void Renderer::flushQueue() {
+    if (queue_.isEmpty()) return;
+
+    queue_.sort();
+    for (const RenderCommand& command : queue_.getCommands()) {
+        if (scanlineMode_) {
+            // Sprites go to the OAM table and cached terrain comes from the
+            // nametables; everything else is still drawn into the overlay
+            ObjectEntry object = {};
+            object.x = command.x;
+            object.y = command.y;
+            if (command.type == RenderCommandType::ATLAS_SPRITE) {
+                const Rect& rect = atlas_.getRect(command.sprite);
+                object.w = static_cast<uint16_t>(rect.w);
+                object.h = static_cast<uint16_t>(rect.h);
+                object.pixels = atlas_.getSurface().getRow(rect.y) + rect.x;
+                object.pitch = static_cast<uint16_t>(atlas_.getSurface().getPitch());
+                object.remap = command.palette != 0 ? queue_.getPalette(command.palette).data() : nullptr;
+                scanline_.addObject(object);
+                continue;
+            }
+            if (command.type == RenderCommandType::PATTERN) {
+                object.w = static_cast<uint16_t>(command.w);
+                object.h = static_cast<uint16_t>(command.h);
+                object.pixels = command.pattern;
+                object.pitch = static_cast<uint16_t>(command.w);
+                object.solid = command.solid;
+                object.color = command.color;
+                scanline_.addObject(object);
+                continue;
             }
+            if (command.type == RenderCommandType::SURFACE || command.type == RenderCommandType::SPANS) {
+                continue;
+            }
+        }
+
+        switch (command.type) {
+            case RenderCommandType::ATLAS_SPRITE:
+                if (command.palette == 0) {
+                    atlas_.getSpans(command.sprite).draw(frameBuffer_, command.x, command.y);
+                } else {
+                    frameBuffer_.blitRemapped(atlas_.getSurface(), atlas_.getRect(command.sprite),
+                                              command.x, command.y, queue_.getPalette(command.palette).data());
+                }
+                break;
+            case RenderCommandType::PATTERN:
+                if (command.solid) {
+                    getPatternSpans(command.pattern, command.w).drawSolid(frameBuffer_, command.x, command.y,
+                                                                          command.color);
+                } else {
+                    getPatternSpans(command.pattern, command.w).draw(frameBuffer_, command.x, command.y);
+                }
+                break;
+            case RenderCommandType::FILL_RECT:
+                frameBuffer_.fillRect(command.x, command.y, command.w, command.h, command.color);
+                break;
+            case RenderCommandType::OUTLINE_RECT:
+                frameBuffer_.drawRect(command.x, command.y, command.w, command.h, command.color);
+                break;
+            case RenderCommandType::TEXT:
+                drawText(command.x, command.y, queue_.getText(command), command.color);
+                break;
+            case RenderCommandType::SURFACE:
+                frameBuffer_.blit(*command.surface, command.surface->getBounds(), command.x, command.y);
+                break;
+            case RenderCommandType::SPANS:
+                if (command.palette == 0) {
+                    command.spans->draw(frameBuffer_, command.x, command.y);
+                } else {
+                    command.spans->drawRemapped(frameBuffer_, command.x, command.y,
+                                                queue_.getPalette(command.palette).data());
+                }
+                break;
         }
-        currentX += 8;
-        ++text;
     }
+    queue_.clear();
 }
 
 void Renderer::drawExplosion(int x, int y, int frame) {
@@ -195,159 +385,141 @@ void Renderer::drawPowerUpIcon(int x, int y, PowerUpType type) {
 }
 
 void Renderer::fadeIn(float alpha) {
-    // Draw semi-transparent black overlay
-    uint8_t alphaByte = static_cast<uint8_t>((1.0f - alpha) * 255);
-    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, alphaByte);
-    SDL_Rect rect = {0, 0, GAME_WIDTH, GAME_HEIGHT};
-    SDL_RenderFillRect(renderer_, &rect);
+    // Fade from black in NES brightness steps
+    effects_.setBrightness(-static_cast<int>((1.0f - alpha) * PaletteEffects::MAX_BRIGHTNESS_STEPS + 0.5f));
 }
 
 void Renderer::fadeOut(float alpha) {
-    // Draw semi-transparent black overlay
-    uint8_t alphaByte = static_cast<uint8_t>(alpha * 255);
-    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, alphaByte);
-    SDL_Rect rect = {0, 0, GAME_WIDTH, GAME_HEIGHT};
-    SDL_RenderFillRect(renderer_, &rect);
+    effects_.setBrightness(-static_cast<int>(alpha * PaletteEffects::MAX_BRIGHTNESS_STEPS + 0.5f));
+}
+
+void Renderer::buildRgbaTable() {
+    // Pre-pack every NES color in SDL_PIXELFORMAT_RGBA8888 layout
+    for (size_t i = 0; i < baseRgba_.size(); ++i) {
+        const SDL_Color& color = palette_->getColor(static_cast<uint8_t>(i));
+        baseRgba_[i] = (static_cast<uint32_t>(color.r) << 24) |
+                       (static_cast<uint32_t>(color.g) << 16) |
+                       (static_cast<uint32_t>(color.b) << 8) |
+                       static_cast<uint32_t>(color.a);
+    }
+    rgbaTable_ = baseRgba_;
+}
+
+void Renderer::applyPaletteEffects() {
+    if (!effects_.consumeChanged()) return;
+
+    PaletteEffects::Remap remap;
+    effects_.buildRemap(remap);
+    for (size_t i = 0; i < rgbaTable_.size(); ++i) {
+        rgbaTable_[i] = baseRgba_[remap[i]];
+    }
+
+    if (softwarePresenter_) softwarePresenter_->setColors(rgbaTable_.data());
+
+    // Unchanged indices now convert to different colors
+    invalidateTextures();
+}
+
+void Renderer::invalidateTextures() {
+    for (DirtyRectTracker& tracker : dirtyRects_) {
+        tracker.invalidateAll();
+    }
 }
 
 void Renderer::updateGameTexture() {
-    // This would copy the rendered pixels to the game texture
-    // For now, we'll just render directly
+    // Convert the regions that changed since this texture was last filled to
+    // RGBA while writing into it; it keeps the rest from earlier frames
+    SDL_Texture* texture = gameTextures_[currentTexture_];
+    DirtyRectTracker& dirtyRects = dirtyRects_[currentTexture_];
+    for (const Rect& rect : dirtyRects.update(frameBuffer_)) {
+        SDL_Rect lockRect = {rect.x, rect.y, rect.w, rect.h};
+        void* texturePixels = nullptr;
+        int texturePitch = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        int locked = SDL_LockTexture(texture, &lockRect, &texturePixels, &texturePitch);
+        timings_.lock += elapsedMilliseconds(start);
+        if (locked != 0) {
+            dirtyRects.invalidateAll();  // Retry everything next time
+            return;
+        }
+
+        start = SDL_GetPerformanceCounter();
+        for (int y = 0; y < rect.h; ++y) {
+            const uint8_t* src = frameBuffer_.getRow(rect.y + y) + rect.x;
+            uint32_t* dst = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(texturePixels) + y * texturePitch);
+            for (int x = 0; x < rect.w; ++x) {
+                dst[x] = rgbaTable_[src[x] & 0x3F];
+            }
+        }
+        SDL_UnlockTexture(texture);
+        timings_.upload += elapsedMilliseconds(start);
+    }
+}
+
+void Renderer::renderScanlines() {
+    // Generate every line straight into the texture memory
+    SDL_Texture* texture = gameTextures_[currentTexture_];
+    void* texturePixels = nullptr;
+    int texturePitch = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    int locked = SDL_LockTexture(texture, nullptr, &texturePixels, &texturePitch);
+    timings_.lock = elapsedMilliseconds(start);
+    if (locked != 0) return;
+
+    start = SDL_GetPerformanceCounter();
+    scanline_.renderFrame(frameBuffer_, rgbaTable_.data(), texturePixels, texturePitch,
+                          isCapturing() ? &scanlineFrame_ : nullptr);
+    SDL_UnlockTexture(texture);
+    timings_.upload = elapsedMilliseconds(start);
+    if (isCapturing()) captureFrame(scanlineFrame_);
+
+    // The dirty rect history no longer matches the texture
+    dirtyRects_[currentTexture_].invalidateAll();
+}
+
+bool Renderer::startCapture(const CaptureSettings& settings) {
+    if (!capture_) capture_ = std::make_unique<FrameCapture>(GAME_WIDTH, GAME_HEIGHT);
+    return capture_->start(settings);
+}
+
+void Renderer::stopCapture() {
+    if (!capture_) return;
+    capture_->stop();
+    std::cout << "Capture stopped: " << capture_->getWrittenFrames() << " frames written, "
+              << capture_->getDroppedFrames() << " dropped" << std::endl;
+    capture_.reset();
+}
+
+void Renderer::captureFrame(const IndexedSurface& frame) {
+    if (isCapturing()) capture_->submit(frame, rgbaTable_.data());
+}
+
+void Renderer::presentSoftware() {
+    if (scanlineMode_) {
+        scanline_.renderFrame(frameBuffer_, softwarePresenter_->getColorTable(), softwarePresenter_->getFrame32(),
+                              softwarePresenter_->getFrame32Pitch(), isCapturing() ? &scanlineFrame_ : nullptr);
+        softwarePresenter_->presentFrame32();
+        if (isCapturing()) captureFrame(scanlineFrame_);
+        dirtyRects_[0].invalidateAll();
+        return;
+    }
+    softwarePresenter_->present(frameBuffer_, dirtyRects_[0].update(frameBuffer_));
+}
+
+const SpanSprite& Renderer::getPatternSpans(const uint8_t* pattern, int size) {
+    // Placeholder patterns are static arrays, so the pointer identifies them
+    SpanSprite& spans = patternCache_[pattern];
+    if (spans.getWidth() != size) {
+        spans.encode(pattern, size, size, size);
+    }
+    return spans;
 }
 
 void Renderer::renderScaled() {
-    // The game texture is already rendered with logical size.
-    // Do NOT clear the renderer here — clearing here erases any pixels
-    // drawn earlier by setPixel/drawText/drawSprite. SDL_RenderSetLogicalSize
-    // will handle scaling when presenting.
-    // (Keeping this function minimal so present() doesn't erase drawings.)
-}
-
-// Font data (8x8 pixel monospace font, NES style)
-const uint8_t Renderer::FONT_DATA[128][8] = {
-    // Space (32)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    // ! (33)
-    {0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x00},
-    // " (34)
-    {0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},
-    // # (35)
-    {0x24, 0x7E, 0x24, 0x24, 0x7E, 0x24, 0x24, 0x00},
-    // $ (36)
-    {0x08, 0x3E, 0x48, 0x3C, 0x12, 0x7C, 0x10, 0x00},
-    // % (37)
-    {0x60, 0x66, 0x0C, 0x18, 0x30, 0x66, 0x06, 0x00},
-    // & (38)
-    {0x3C, 0x42, 0x3C, 0x42, 0x42, 0x3C, 0x02, 0x00},
-    // ' (39)
-    {0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},
-    // ( (40)
-    {0x0C, 0x18, 0x30, 0x30, 0x30, 0x18, 0x0C, 0x00},
-    // ) (41)
-    {0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x18, 0x30, 0x00},
-    // * (42)
-    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},
-    // + (43)
-    {0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x00},
-    // , (44)
-    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30, 0x00},
-    // - (45)
-    {0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00},
-    // . (46)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00},
-    // / (47)
-    {0x00, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x00, 0x00},
-    // Numbers 0-9 (48-57)
-    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // 0
-    {0x08, 0x18, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // 1
-    {0x3C, 0x42, 0x02, 0x3C, 0x40, 0x40, 0x7E, 0x00}, // 2
-    {0x3C, 0x42, 0x02, 0x1C, 0x02, 0x42, 0x3C, 0x00}, // 3
-    {0x04, 0x0C, 0x14, 0x24, 0x7E, 0x04, 0x04, 0x00}, // 4
-    {0x7E, 0x40, 0x7C, 0x02, 0x02, 0x42, 0x3C, 0x00}, // 5
-    {0x3C, 0x40, 0x7C, 0x42, 0x42, 0x42, 0x3C, 0x00}, // 6
-    {0x7E, 0x02, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00}, // 7
-    {0x3C, 0x42, 0x42, 0x3C, 0x42, 0x42, 0x3C, 0x00}, // 8
-    {0x3C, 0x42, 0x42, 0x3E, 0x02, 0x42, 0x3C, 0x00}, // 9
-    // : (58)
-    {0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00},
-    // ; (59)
-    {0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x30, 0x00},
-    // < (60)
-    {0x0C, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x00},
-    // = (61)
-    {0x00, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x00, 0x00},
-    // > (62)
-    {0x30, 0x18, 0x0C, 0x06, 0x0C, 0x18, 0x30, 0x00},
-    // ? (63)
-    {0x3C, 0x42, 0x04, 0x08, 0x08, 0x00, 0x08, 0x00},
-    // @ (64)
-    {0x3C, 0x42, 0x4E, 0x52, 0x4E, 0x40, 0x3C, 0x00},
-    // Uppercase A-Z (65-90)
-    {0x18, 0x24, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x00}, // A
-    {0x7C, 0x42, 0x42, 0x7C, 0x42, 0x42, 0x7C, 0x00}, // B
-    {0x3C, 0x42, 0x40, 0x40, 0x40, 0x42, 0x3C, 0x00}, // C
-    {0x78, 0x44, 0x42, 0x42, 0x42, 0x44, 0x78, 0x00}, // D
-    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x7E, 0x00}, // E
-    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x40, 0x00}, // F
-    {0x3C, 0x42, 0x40, 0x4E, 0x42, 0x42, 0x3C, 0x00}, // G
-    {0x42, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x42, 0x00}, // H
-    {0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // I
-    {0x02, 0x02, 0x02, 0x02, 0x42, 0x42, 0x3C, 0x00}, // J
-    {0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00}, // K
-    {0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7E, 0x00}, // L
-    {0x42, 0x66, 0x5A, 0x42, 0x42, 0x42, 0x42, 0x00}, // M
-    {0x42, 0x62, 0x52, 0x4A, 0x46, 0x42, 0x42, 0x00}, // N
-    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // O
-    {0x7C, 0x42, 0x42, 0x7C, 0x40, 0x40, 0x40, 0x00}, // P
-    {0x3C, 0x42, 0x42, 0x42, 0x4A, 0x44, 0x3A, 0x00}, // Q
-    {0x7C, 0x42, 0x42, 0x7C, 0x48, 0x44, 0x42, 0x00}, // R
-    {0x3C, 0x42, 0x40, 0x3C, 0x02, 0x42, 0x3C, 0x00}, // S
-    {0x7E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // T
-    {0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // U
-    {0x42, 0x42, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00}, // V
-    {0x42, 0x42, 0x42, 0x42, 0x5A, 0x66, 0x42, 0x00}, // W
-    {0x42, 0x24, 0x18, 0x18, 0x18, 0x24, 0x42, 0x00}, // X
-    {0x42, 0x42, 0x24, 0x18, 0x18, 0x18, 0x18, 0x00}, // Y
-    {0x7E, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7E, 0x00}, // Z (90)
-    // Fill remaining slots with empty (for characters 91-127)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // [ (91)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // \ (92)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ] (93)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ^ (94)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // _ (95)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ` (96)
-    // Lowercase a-z (97-122) - using uppercase glyphs for now
-    {0x18, 0x24, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x00}, // a (97)
-    {0x7C, 0x42, 0x42, 0x7C, 0x42, 0x42, 0x7C, 0x00}, // b (98)
-    {0x3C, 0x42, 0x40, 0x40, 0x40, 0x42, 0x3C, 0x00}, // c (99)
-    {0x78, 0x44, 0x42, 0x42, 0x42, 0x44, 0x78, 0x00}, // d (100)
-    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x7E, 0x00}, // e (101)
-    {0x7E, 0x40, 0x40, 0x7C, 0x40, 0x40, 0x40, 0x00}, // f (102)
-    {0x3C, 0x42, 0x40, 0x4E, 0x42, 0x42, 0x3C, 0x00}, // g (103)
-    {0x42, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x42, 0x00}, // h (104)
-    {0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00}, // i (105)
-    {0x02, 0x02, 0x02, 0x02, 0x42, 0x42, 0x3C, 0x00}, // j (106)
-    {0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00}, // k (107)
-    {0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7E, 0x00}, // l (108)
-    {0x42, 0x66, 0x5A, 0x42, 0x42, 0x42, 0x42, 0x00}, // m (109)
-    {0x42, 0x62, 0x52, 0x4A, 0x46, 0x42, 0x42, 0x00}, // n (110)
-    {0x3C, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // o (111)
-    {0x7C, 0x42, 0x42, 0x7C, 0x40, 0x40, 0x40, 0x00}, // p (112)
-    {0x3C, 0x42, 0x42, 0x42, 0x4A, 0x44, 0x3A, 0x00}, // q (113)
-    {0x7C, 0x42, 0x42, 0x7C, 0x48, 0x44, 0x42, 0x00}, // r (114)
-    {0x3C, 0x42, 0x40, 0x3C, 0x02, 0x42, 0x3C, 0x00}, // s (115)
-    {0x7E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // t (116)
-    {0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3C, 0x00}, // u (117)
-    {0x42, 0x42, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00}, // v (118)
-    {0x42, 0x42, 0x42, 0x42, 0x5A, 0x66, 0x42, 0x00}, // w (119)
-    {0x42, 0x24, 0x18, 0x18, 0x18, 0x24, 0x42, 0x00}, // x (120)
-    {0x42, 0x42, 0x24, 0x18, 0x18, 0x18, 0x18, 0x00}, // y (121)
-    {0x7E, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7E, 0x00}, // z (122)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // { (123)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // | (124)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // } (125)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ~ (126)
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // DEL (127)
-};
-
-} // namespace BattleCity
\ No newline at end of file
+    // SDL_RenderSetLogicalSize scales the 256x224 texture to the window
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(renderer_);
+    SDL_RenderCopy(renderer_, gameTextures_[currentTexture_], nullptr, nullptr);
+}
+
+} // namespace BattleCity
@@ -1,21 +1,87 @@
 #pragma once
 
 #include <SDL.h>
+#include <array>
 #include <memory>
+#include <unordered_map>
 #include "Palette.h"
+#include "IndexedSurface.h"
+#include "SpriteAtlas.h"
+#include "RenderQueue.h"
+#include "BitmapFont.h"
+#include "DirtyRectTracker.h"
+#include "ScanlineRenderer.h"
+#include "PaletteEffects.h"
+#include "SoftwarePresenter.h"
+#include "FrameCapture.h"
 #include "../utils/MathUtils.h"
 #include "../gameplay/PowerUp.h"
 
 namespace BattleCity {
 
+// Time spent in each present phase, in milliseconds
+struct PresentTimings {
+    double lock = 0.0;      // SDL_LockTexture calls
+    double upload = 0.0;    // Converting pixels into the locked texture
+    double present = 0.0;   // SDL_RenderCopy + SDL_RenderPresent
+    double peakPresent = 0.0;  // Worst present since the last resetPeaks()
+    uint32_t frames = 0;
+
+    void resetPeaks() { peakPresent = 0.0; }
+};
+
 // Pixel-perfect renderer for NES-style graphics
 class Renderer {
 private:
     SDL_Window* window_;
     SDL_Renderer* renderer_;
-    SDL_Texture* gameTexture_;  // 256x224 game texture
+    // 256x224 streaming textures, rotated every frame: one is filled while
+    // the GPU may still be reading the ones presented before it
+    static constexpr int TEXTURE_COUNT = 3;
+    std::array<SDL_Texture*, TEXTURE_COUNT> gameTextures_;
+    int currentTexture_;
+
+    // Used instead of renderer_/gameTextures_ when no accelerated renderer exists
+    std::unique_ptr<SoftwarePresenter> softwarePresenter_;
     std::unique_ptr<Palette> palette_;
 
+    // All drawing goes into an indexed frame buffer which is converted to
+    // RGBA and uploaded to a game texture once per frame in present()
+    IndexedSurface frameBuffer_;
+    std::array<uint32_t, 64> baseRgba_;   // Palette index -> RGBA8888
+    std::array<uint32_t, 64> rgbaTable_;  // Same with the palette effects applied
+    PaletteEffects effects_;
+
+    // Only regions that changed since a texture was last filled are converted
+    // and uploaded; each texture is three frames behind, so each has a tracker
+    std::array<DirtyRectTracker, TEXTURE_COUNT> dirtyRects_;
+
+    // Per-frame cost of the present phases
+    PresentTimings timings_;
+
+    // Sprite art from assets/sprites, packed into one indexed atlas
+    SpriteAtlas atlas_;
+
+    // Deferred draws of the current frame, rasterized by flushQueue()
+    RenderQueue queue_;
+
+    // Top-left of the screen in world pixels (large arenas scroll)
+    int cameraX_;
+    int cameraY_;
+
+    // Span-encoded placeholder patterns, keyed by their (static) pixel data
+    std::unordered_map<const uint8_t*, SpanSprite> patternCache_;
+
+    // Optional NES-style output: queued sprites become OAM entries and the
+    // frame is generated per scanline into the texture (frameBuffer_ then
+    // only holds immediate-mode drawing, 0 = transparent)
+    ScanlineRenderer scanline_;
+    bool scanlineMode_;
+
+    // Session recording; scanlineFrame_ receives the composed frame in scanline mode
+    std::unique_ptr<FrameCapture> capture_;
+    IndexedSurface scanlineFrame_;
+
     int scaleFactor_;
     bool vsyncEnabled_;
     static constexpr int GAME_WIDTH = 256;
@@ -28,6 +94,11 @@ public:
     // Initialize SDL and create window/renderer
     bool init();
 
+    // Decode and pack all sprite PNGs (placeholder graphics are used if this fails)
+    bool loadSprites(const std::string& spriteRoot);
+    bool loadSprites(const AssetPack& pack) { return atlas_.loadPack(pack); }
+    const SpriteAtlas& getAtlas() const { return atlas_; }
+
     // Clear screen
     void clear();
 
@@ -42,34 +113,85 @@ public:
     void fillRect(int x, int y, int w, int h, uint8_t colorIndex);
     void drawRect(int x, int y, int w, int h, uint8_t colorIndex);
 
+    // Copy a cached indexed layer into the frame buffer
+    void blit(const IndexedSurface& surface, int x, int y);
+    void blit(const IndexedSurface& surface, const Rect& sourceRect, int x, int y);
+
     // Sprite rendering (8x8 pixels)
     void drawSprite(int x, int y, const uint8_t* spriteData, uint8_t colorIndex = 0x20);
 
+    // Atlas sprite rendering (top-left position, index 0 is transparent)
+    void drawAtlasSprite(SpriteId sprite, int x, int y);
+    void drawAtlasSpriteCentered(SpriteId sprite, int centerX, int centerY);
+
     // Text rendering
     void drawText(int x, int y, const char* text, uint8_t colorIndex = 0x20);
 
+    // Deferred rendering: queued draws are sorted by layer and drawn by
+    // flushQueue() (present() flushes anything still queued)
+    void queueSprite(RenderLayer layer, SpriteId sprite, int x, int y, uint8_t palette = 0);
+    void queueSpriteCentered(RenderLayer layer, SpriteId sprite, int centerX, int centerY, uint8_t palette = 0);
+    void queuePattern(RenderLayer layer, int x, int y, const uint8_t* pattern, int size);  // In its own colors
+    void queuePattern(RenderLayer layer, int x, int y, const uint8_t* pattern, int size, uint8_t colorIndex);
+    void queueRect(RenderLayer layer, int x, int y, int w, int h, uint8_t colorIndex);
+    void queueOutline(RenderLayer layer, int x, int y, int w, int h, uint8_t colorIndex);
+    void queueText(RenderLayer layer, int x, int y, const char* text, uint8_t colorIndex = 0x20);
+    void queueSurface(RenderLayer layer, const IndexedSurface& surface, int x, int y);
+    void queueSpans(RenderLayer layer, const SpanSprite& spans, int x, int y, uint8_t palette = 0);
+    void flushQueue();
+    RenderQueue& getQueue() { return queue_; }
+
+    // Queued draws below the HUD layer are in world pixels: they are moved
+    // by the camera and dropped when they end up off screen
+    void setCamera(int x, int y) { cameraX_ = x; cameraY_ = y; }
+    Rect getView() const { return Rect(cameraX_, cameraY_, GAME_WIDTH, GAME_HEIGHT); }
+
+    // Scanline mode (background from nametables, sprites from the OAM table)
+    void setScanlineMode(bool enabled);
+    bool isScanlineMode() const { return scanlineMode_; }
+    ScanlineRenderer& getScanline() { return scanline_; }
+
     // Special effects
     void drawExplosion(int x, int y, int frame);
     void drawShield(int x, int y, int frame);
     void drawPowerUpIcon(int x, int y, PowerUpType type);
 
-    // Screen effects
+    // Screen effects, applied through the palette when the frame is converted.
+    // Brightness and flash last for the current frame (clear() resets them).
     void fadeIn(float alpha);
     void fadeOut(float alpha);
+    void setBrightness(int steps) { effects_.setBrightness(steps); }
+    void flashWhite(bool enabled) { effects_.setFlash(enabled); }
+    void setWaterPhase(int phase) { effects_.setCyclePhase(phase); }
+
+    // Frame capture (encoded on a background thread, frames are dropped
+    // rather than stalling the game when the encoder falls behind)
+    bool startCapture(const CaptureSettings& settings);
+    void stopCapture();
+    const FrameCapture* getCapture() const { return capture_.get(); }
 
     // Getters
     int getWidth() const { return GAME_WIDTH; }
     int getHeight() const { return GAME_HEIGHT; }
     int getScaleFactor() const { return scaleFactor_; }
     SDL_Window* getWindow() const { return window_; }
+    bool isSoftwarePresenter() const { return softwarePresenter_ != nullptr; }
+    int getLastUploadArea() const { return dirtyRects_[currentTexture_].getDirtyArea(); }  // Pixels uploaded last frame
+    const PresentTimings& getTimings() const { return timings_; }
 
 private:
     // Internal rendering helpers
+    void buildRgbaTable();
+    void applyPaletteEffects();
+    void invalidateTextures();
     void updateGameTexture();
+    void renderScanlines();
+    void presentSoftware();
+    bool isCapturing() const { return capture_ && capture_->isRunning(); }
+    void captureFrame(const IndexedSurface& frame);
     void renderScaled();
-
-    // Font data (8x8 pixel font)
-    static const uint8_t FONT_DATA[128][8];
+    const SpanSprite& getPatternSpans(const uint8_t* pattern, int size);
+    bool toScreen(RenderLayer layer, int& x, int& y, int w, int h) const;
 };
 
 // Sprite data structure
@@ -0,0 +1,198 @@
+#include "ScanlineRenderer.h"
+#include "Palette.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace BattleCity {
+
+ScanlineRenderer::ScanlineRenderer()
+    : backgroundVisible_(false), backgroundVersion_(0), backdropColor_(BattleCityPalette::COLOR_BLACK),
+      objectCount_(0), droppedObjects_(0), droppedLines_(0), spriteLimit_(true), frameCounter_(0) {
+    background_.fill(NO_TILE);
+    foreground_.fill(NO_TILE);
+    line_.fill(0);
+}
+
+void ScanlineRenderer::setBackground(uint32_t version, const IndexedSurface& ground, const IndexedSurface* overlay,
+                                     const IndexedSurface* front, int x, int y) {
+    if (version != 0 && version == backgroundVersion_) return;
+    backgroundVersion_ = version;
+
+    patterns_.clear();
+    patternIndex_.clear();
+    background_.fill(NO_TILE);
+    foreground_.fill(NO_TILE);
+
+    Pattern pattern;
+    for (int cellY = 0; cellY < NAMETABLE_HEIGHT; ++cellY) {
+        for (int cellX = 0; cellX < NAMETABLE_WIDTH; ++cellX) {
+            int layerX = cellX * TILE_SIZE - x;
+            int layerY = cellY * TILE_SIZE - y;
+            if (layerX + TILE_SIZE <= 0 || layerY + TILE_SIZE <= 0 ||
+                layerX >= ground.getWidth() || layerY >= ground.getHeight()) {
+                continue;  // Cell shows the backdrop
+            }
+
+            // Background cell: ground with the overlay's opaque pixels on top
+            for (int py = 0; py < TILE_SIZE; ++py) {
+                for (int px = 0; px < TILE_SIZE; ++px) {
+                    int sx = layerX + px;
+                    int sy = layerY + py;
+                    uint8_t value = backdropColor_;
+                    if (sx >= 0 && sy >= 0 && sx < ground.getWidth() && sy < ground.getHeight()) {
+                        value = ground.getPixel(sx, sy);
+                        if (overlay && overlay->getPixel(sx, sy) != 0) value = overlay->getPixel(sx, sy);
+                    }
+                    pattern[py * TILE_SIZE + px] = value;
+                }
+            }
+            background_[cellY * NAMETABLE_WIDTH + cellX] = addPattern(pattern);
+
+            // Foreground cell, left empty when it has no opaque pixel
+            if (!front) continue;
+            bool opaque = false;
+            for (int py = 0; py < TILE_SIZE; ++py) {
+                for (int px = 0; px < TILE_SIZE; ++px) {
+                    uint8_t value = front->getPixel(layerX + px, layerY + py);
+                    pattern[py * TILE_SIZE + px] = value;
+                    opaque |= value != 0;
+                }
+            }
+            if (opaque) {
+                foreground_[cellY * NAMETABLE_WIDTH + cellX] = addPattern(pattern);
+            }
+        }
+    }
+}
+
+void ScanlineRenderer::beginFrame() {
+    objectCount_ = 0;
+    droppedObjects_ = 0;
+    backgroundVisible_ = false;
+}
+
+bool ScanlineRenderer::addObject(const ObjectEntry& object) {
+    if (!object.pixels || object.w == 0 || object.h == 0) return false;
+    if (objectCount_ >= MAX_OBJECTS) {
+        ++droppedObjects_;
+        return false;
+    }
+    objects_[objectCount_++] = object;
+    return true;
+}
+
+void ScanlineRenderer::renderFrame(const IndexedSurface& overlay, const uint32_t* rgbaTable, void* pixels, int pitch,
+                                   IndexedSurface* composed) {
+    bool hasOverlay = overlay.getWidth() == SCREEN_WIDTH && overlay.getHeight() == SCREEN_HEIGHT;
+    if (composed && (composed->getWidth() != SCREEN_WIDTH || composed->getHeight() != SCREEN_HEIGHT)) {
+        composed->resize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    droppedLines_ = 0;
+
+    for (int y = 0; y < SCREEN_HEIGHT; ++y) {
+        uint32_t* out = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + y * pitch);
+        renderScanline(y, hasOverlay ? overlay.getRow(y) : nullptr, rgbaTable, out);
+        if (composed) std::memcpy(composed->getRow(y), line_.data(), SCREEN_WIDTH);
+    }
+    ++frameCounter_;
+}
+
+uint16_t ScanlineRenderer::addPattern(const Pattern& pattern) {
+    auto found = patternIndex_.find(pattern);
+    if (found != patternIndex_.end()) return found->second;
+
+    uint16_t index = static_cast<uint16_t>(patterns_.size());
+    patterns_.push_back(pattern);
+    patternIndex_.emplace(pattern, index);
+    return index;
+}
+
+void ScanlineRenderer::renderScanline(int y, const uint8_t* overlayRow, const uint32_t* rgbaTable, uint32_t* out) {
+    uint8_t* line = line_.data();
+    int cellRow = (y / TILE_SIZE) * NAMETABLE_WIDTH;
+    int fineY = (y % TILE_SIZE) * TILE_SIZE;
+
+    // Background
+    if (backgroundVisible_) {
+        for (int cellX = 0; cellX < NAMETABLE_WIDTH; ++cellX) {
+            uint16_t tile = background_[cellRow + cellX];
+            if (tile == NO_TILE) {
+                std::memset(line + cellX * TILE_SIZE, backdropColor_, TILE_SIZE);
+            } else {
+                std::memcpy(line + cellX * TILE_SIZE, patterns_[tile].data() + fineY, TILE_SIZE);
+            }
+        }
+    } else {
+        std::memset(line, backdropColor_, SCREEN_WIDTH);
+    }
+
+    // Sprite evaluation: pick the objects on this line, at most 8 tiles wide
+    // in total when limited, starting at a per-frame rotating index
+    std::bitset<MAX_OBJECTS> selected;
+    int start = spriteLimit_ && objectCount_ > 0 ? static_cast<int>(frameCounter_ % objectCount_) : 0;
+    int tilesUsed = 0;
+    bool overflow = false;
+    for (int n = 0; n < objectCount_; ++n) {
+        int i = (start + n) % objectCount_;
+        const ObjectEntry& object = objects_[i];
+        if (y < object.y || y >= object.y + object.h) continue;
+
+        int tiles = (object.w + TILE_SIZE - 1) / TILE_SIZE;
+        if (spriteLimit_ && tilesUsed + tiles > SPRITE_TILES_PER_LINE) {
+            overflow = true;
+            continue;
+        }
+        tilesUsed += tiles;
+        selected.set(i);
+    }
+    if (overflow) ++droppedLines_;
+
+    // Draw in OAM order so later entries (higher layers) end up on top
+    for (int i = 0; i < objectCount_; ++i) {
+        if (selected.test(i)) drawObjectRow(objects_[i], y - objects_[i].y);
+    }
+
+    // Foreground (canopy) over the sprites
+    if (backgroundVisible_) {
+        for (int cellX = 0; cellX < NAMETABLE_WIDTH; ++cellX) {
+            uint16_t tile = foreground_[cellRow + cellX];
+            if (tile == NO_TILE) continue;
+            const uint8_t* src = patterns_[tile].data() + fineY;
+            uint8_t* dst = line + cellX * TILE_SIZE;
+            for (int px = 0; px < TILE_SIZE; ++px) {
+                if (src[px] != 0) dst[px] = src[px];
+            }
+        }
+    }
+
+    // Immediate-mode drawing (HUD, menus) on top
+    if (overlayRow) {
+        for (int x = 0; x < SCREEN_WIDTH; ++x) {
+            if (overlayRow[x] != OVERLAY_CLEAR) line[x] = overlayRow[x];
+        }
+    }
+
+    for (int x = 0; x < SCREEN_WIDTH; ++x) {
+        out[x] = rgbaTable[line[x] & 0x3F];
+    }
+}
+
+void ScanlineRenderer::drawObjectRow(const ObjectEntry& object, int row) {
+    const uint8_t* src = object.pixels + row * object.pitch;
+    int first = std::max(0, -object.x);
+    int last = std::min<int>(object.w, SCREEN_WIDTH - object.x);
+
+    for (int i = first; i < last; ++i) {
+        uint8_t value = src[i];
+        if (value == 0) continue;
+        if (object.solid) {
+            value = object.color;
+        } else if (object.remap) {
+            value = object.remap[value & 0x3F];
+        }
+        line_[object.x + i] = value;
+    }
+}
+
+} // namespace BattleCity
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace BattleCity {
+
+// One object attribute entry: a sprite placed on screen for this frame
+struct ObjectEntry {
+    int16_t x, y;
+    uint16_t w, h;
+    const uint8_t* pixels;   // Indexed pixels, 0 = transparent; must outlive the frame
+    uint16_t pitch;
+    bool solid;              // Draw every opaque pixel in color (placeholder patterns)
+    uint8_t color;
+    const uint8_t* remap;    // Optional 64-entry palette remap
+};
+
+// NES-style renderer. The background is a 32x28 nametable of 8x8 patterns
+// (plus a foreground table for the forest canopy) and sprites are an OAM
+// table rebuilt every frame. The frame is produced one scanline at a time
+// straight into the texture memory, so nothing is rasterized into an
+// intermediate frame buffer first.
+//
+// Like the hardware, at most 8 sprite tiles (8 pixels wide each) are shown
+// per scanline when the limit is enabled; the start of the evaluation is
+// rotated every frame so overflowing sprites flicker instead of vanishing.
+class ScanlineRenderer {
+public:
+    static constexpr int SCREEN_WIDTH = 256;
+    static constexpr int SCREEN_HEIGHT = 224;
+    static constexpr int TILE_SIZE = 8;
+    static constexpr int NAMETABLE_WIDTH = SCREEN_WIDTH / TILE_SIZE;    // 32
+    static constexpr int NAMETABLE_HEIGHT = SCREEN_HEIGHT / TILE_SIZE;  // 28
+    static constexpr int MAX_OBJECTS = 64;
+    static constexpr int SPRITE_TILES_PER_LINE = 8;
+    static constexpr uint8_t OVERLAY_CLEAR = 0xFF;  // Overlay pixel showing the scanline output (colors are 0-63)
+    static constexpr uint16_t NO_TILE = 0xFFFF;  // Nametable cell without a pattern
+
+private:
+    using Pattern = std::array<uint8_t, TILE_SIZE * TILE_SIZE>;
+
+    // Pattern table and its lookup for dedup (identical 8x8 cells share one)
+    std::vector<Pattern> patterns_;
+    std::map<Pattern, uint16_t> patternIndex_;
+
+    std::array<uint16_t, NAMETABLE_WIDTH * NAMETABLE_HEIGHT> background_;
+    std::array<uint16_t, NAMETABLE_WIDTH * NAMETABLE_HEIGHT> foreground_;
+    bool backgroundVisible_;
+    uint32_t backgroundVersion_;
+    uint8_t backdropColor_;
+
+    std::array<ObjectEntry, MAX_OBJECTS> objects_;
+    int objectCount_;
+    int droppedObjects_;     // OAM overflow this frame
+    int droppedLines_;       // Scanlines that hit the sprite limit this frame
+    bool spriteLimit_;
+    uint32_t frameCounter_;
+
+    std::array<uint8_t, SCREEN_WIDTH> line_;
+
+public:
+    ScanlineRenderer();
+
+    // Rebuild the nametables from cached layers placed at (x, y): the
+    // background from the opaque ground plus an optional transparent layer
+    // on top (water), the foreground from an optional transparent layer.
+    // Nothing is rebuilt when version matches the tables already built
+    // (version 0 means never built).
+    void setBackground(uint32_t version, const IndexedSurface& ground, const IndexedSurface* overlay,
+                       const IndexedSurface* front, int x, int y);
+    void setBackgroundVisible(bool visible) { backgroundVisible_ = visible; }
+    void setBackdropColor(uint8_t colorIndex) { backdropColor_ = colorIndex; }
+
+    // Start a new frame: clears the OAM and hides the background until it
+    // is shown again by whoever owns it
+    void beginFrame();
+    bool addObject(const ObjectEntry& object);
+
+    void setSpriteLimit(bool enabled) { spriteLimit_ = enabled; }
+    bool hasSpriteLimit() const { return spriteLimit_; }
+
+    // Produce the frame into RGBA8888 memory (e.g. a locked texture).
+    // overlay pixels other than OVERLAY_CLEAR are drawn last (HUD and other
+    // immediate-mode drawing). The composed indices are also copied to
+    // composed when given (frame capture).
+    void renderFrame(const IndexedSurface& overlay, const uint32_t* rgbaTable, void* pixels, int pitch,
+                     IndexedSurface* composed = nullptr);
+
+    int getObjectCount() const { return objectCount_; }
+    int getDroppedObjects() const { return droppedObjects_; }
+    int getDroppedLines() const { return droppedLines_; }
+    int getPatternCount() const { return static_cast<int>(patterns_.size()); }
+
+private:
+    uint16_t addPattern(const Pattern& pattern);
+    void renderScanline(int y, const uint8_t* overlayRow, const uint32_t* rgbaTable, uint32_t* out);
+    void drawObjectRow(const ObjectEntry& object, int row);
+};
+
+} // namespace BattleCity
@@ -0,0 +1,207 @@
+#include "SoftwarePresenter.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATTLECITY_HAS_SSE2 1
+#endif
+
+namespace BattleCity {
+
+namespace {
+
+// Write every source pixel scale times in a row
+void replicateRow(const uint32_t* src, int count, uint32_t* dst, int scale) {
+    int x = 0;
+
+#ifdef BATTLECITY_HAS_SSE2
+    // Four source pixels per step, widened with 32-bit shuffles
+    switch (scale) {
+        case 2:
+            for (; x + 4 <= count; x += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+                __m128i* out = reinterpret_cast<__m128i*>(dst + x * 2);
+                _mm_storeu_si128(out, _mm_unpacklo_epi32(v, v));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi32(v, v));
+            }
+            break;
+        case 3:
+            for (; x + 4 <= count; x += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+                __m128i* out = reinterpret_cast<__m128i*>(dst + x * 3);
+                _mm_storeu_si128(out, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 0, 0)));
+                _mm_storeu_si128(out + 1, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 1)));
+                _mm_storeu_si128(out + 2, _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 2)));
+            }
+            break;
+        case 4:
+            for (; x + 4 <= count; x += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+                __m128i* out = reinterpret_cast<__m128i*>(dst + x * 4);
+                _mm_storeu_si128(out, _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 0, 0)));
+                _mm_storeu_si128(out + 1, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 1, 1)));
+                _mm_storeu_si128(out + 2, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 2, 2)));
+                _mm_storeu_si128(out + 3, _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+            break;
+        default:
+            break;
+    }
+#endif
+
+    for (; x < count; ++x) {
+        for (int i = 0; i < scale; ++i) {
+            dst[x * scale + i] = src[x];
+        }
+    }
+}
+
+} // namespace
+
+SoftwarePresenter::SoftwarePresenter(int sourceWidth, int sourceHeight)
+    : window_(nullptr), sourceWidth_(sourceWidth), sourceHeight_(sourceHeight),
+      frame32_(static_cast<size_t>(sourceWidth) * sourceHeight, 0), rowBuffer_(sourceWidth, 0), scale_(MIN_SCALE),
+      offsetX_(0), offsetY_(0), surfaceWidth_(0), surfaceHeight_(0), fullUpdate_(true) {
+    colorTable_.fill(0);
+}
+
+bool SoftwarePresenter::init(SDL_Window* window) {
+    window_ = window;
+    SDL_Surface* surface = window_ ? SDL_GetWindowSurface(window_) : nullptr;
+    if (!surface) {
+        std::cerr << "No window surface: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    if (surface->format->BytesPerPixel != 4) {
+        std::cerr << "Window surface is not 32-bit, software presenter unavailable" << std::endl;
+        return false;
+    }
+    fitToSurface(surface);
+    fullUpdate_ = true;
+    return true;
+}
+
+void SoftwarePresenter::setColors(const uint32_t* rgba8888) {
+    SDL_Surface* surface = window_ ? SDL_GetWindowSurface(window_) : nullptr;
+    if (!surface) return;
+
+    for (size_t i = 0; i < colorTable_.size(); ++i) {
+        uint32_t color = rgba8888[i];
+        colorTable_[i] = SDL_MapRGBA(surface->format, static_cast<Uint8>(color >> 24), static_cast<Uint8>(color >> 16),
+                                     static_cast<Uint8>(color >> 8), static_cast<Uint8>(color));
+    }
+}
+
+bool SoftwarePresenter::present(const IndexedSurface& frame, const std::vector<Rect>& dirtyRects) {
+    SDL_Surface* surface = beginFrame();
+    if (!surface) return false;
+
+    if (fullUpdate_) {
+        clearSurface(surface);
+        scaleRect(surface, frame.getBounds(), &frame);
+    } else {
+        for (const Rect& rect : dirtyRects) {
+            scaleRect(surface, rect, &frame);
+        }
+    }
+
+    endFrame(surface);
+    if (fullUpdate_) {
+        fullUpdate_ = false;
+        return SDL_UpdateWindowSurface(window_) == 0;
+    }
+    pushRects(dirtyRects);
+    return updateRects_.empty() ||
+           SDL_UpdateWindowSurfaceRects(window_, updateRects_.data(), static_cast<int>(updateRects_.size())) == 0;
+}
+
+bool SoftwarePresenter::presentFrame32() {
+    SDL_Surface* surface = beginFrame();
+    if (!surface) return false;
+
+    if (fullUpdate_) clearSurface(surface);
+    scaleRect(surface, Rect(0, 0, sourceWidth_, sourceHeight_), nullptr);
+    endFrame(surface);
+
+    fullUpdate_ = false;
+    return SDL_UpdateWindowSurface(window_) == 0;
+}
+
+SDL_Surface* SoftwarePresenter::beginFrame() {
+    SDL_Surface* surface = SDL_GetWindowSurface(window_);
+    if (!surface || surface->format->BytesPerPixel != 4) return nullptr;
+
+    fitToSurface(surface);
+
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) return nullptr;
+    return surface;
+}
+
+void SoftwarePresenter::fitToSurface(SDL_Surface* surface) {
+    if (surface->w == surfaceWidth_ && surface->h == surfaceHeight_) return;
+
+    // Pick the largest integer scale that fits and center the output
+    surfaceWidth_ = surface->w;
+    surfaceHeight_ = surface->h;
+    scale_ = std::min(surface->w / sourceWidth_, surface->h / sourceHeight_);
+    scale_ = std::max(MIN_SCALE, std::min(MAX_SCALE, scale_));
+    offsetX_ = std::max(0, (surface->w - sourceWidth_ * scale_) / 2);
+    offsetY_ = std::max(0, (surface->h - sourceHeight_ * scale_) / 2);
+    fullUpdate_ = true;
+}
+
+void SoftwarePresenter::endFrame(SDL_Surface* surface) {
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+}
+
+void SoftwarePresenter::clearSurface(SDL_Surface* surface) {
+    uint32_t black = SDL_MapRGBA(surface->format, 0, 0, 0, 255);
+    for (int y = 0; y < surface->h; ++y) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(surface->pixels) + y * surface->pitch);
+        std::fill(row, row + surface->w, black);
+    }
+}
+
+void SoftwarePresenter::scaleRect(SDL_Surface* surface, const Rect& rect, const IndexedSurface* frame) {
+    // The output may be clipped by a window smaller than 1x
+    int width = std::min(rect.w, (surface->w - offsetX_) / scale_ - rect.x);
+    int height = std::min(rect.h, (surface->h - offsetY_) / scale_ - rect.y);
+    if (width <= 0 || height <= 0) return;
+
+    int rowBytes = width * scale_ * 4;
+
+    for (int y = 0; y < height; ++y) {
+        int sourceY = rect.y + y;
+        const uint32_t* src;
+        if (frame) {
+            const uint8_t* indexed = frame->getRow(sourceY) + rect.x;
+            for (int x = 0; x < width; ++x) {
+                rowBuffer_[x] = colorTable_[indexed[x] & 0x3F];
+            }
+            src = rowBuffer_.data();
+        } else {
+            src = frame32_.data() + sourceY * sourceWidth_ + rect.x;
+        }
+
+        uint8_t* first = static_cast<uint8_t*>(surface->pixels) +
+                         (offsetY_ + sourceY * scale_) * surface->pitch + (offsetX_ + rect.x * scale_) * 4;
+        replicateRow(src, width, reinterpret_cast<uint32_t*>(first), scale_);
+        for (int i = 1; i < scale_; ++i) {
+            std::memcpy(first + i * surface->pitch, first, rowBytes);
+        }
+    }
+}
+
+void SoftwarePresenter::pushRects(const std::vector<Rect>& rects) {
+    updateRects_.clear();
+    for (const Rect& rect : rects) {
+        SDL_Rect scaled = {offsetX_ + rect.x * scale_, offsetY_ + rect.y * scale_, rect.w * scale_, rect.h * scale_};
+        scaled.w = std::min(scaled.w, surfaceWidth_ - scaled.x);
+        scaled.h = std::min(scaled.h, surfaceHeight_ - scaled.y);
+        if (scaled.w > 0 && scaled.h > 0) updateRects_.push_back(scaled);
+    }
+}
+
+} // namespace BattleCity
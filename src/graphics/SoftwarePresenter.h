@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "IndexedSurface.h"
+#include "../utils/MathUtils.h"
+
+namespace BattleCity {
+
+// Presents the frame without an SDL renderer: the indexed frame is converted
+// and scaled by an integer factor (2x/3x/4x) straight into the window
+// surface. Used when no accelerated renderer exists (headless VMs, old thin
+// clients), where SDL's generic software scaler would be much slower.
+//
+// Pixels are replicated horizontally with SSE2 where available and each
+// finished row is copied down for the vertical factor. Only the regions
+// reported dirty are scaled and pushed to the window.
+class SoftwarePresenter {
+public:
+    static constexpr int MIN_SCALE = 1;
+    static constexpr int MAX_SCALE = 4;
+
+private:
+    SDL_Window* window_;
+    int sourceWidth_;
+    int sourceHeight_;
+    std::array<uint32_t, 64> colorTable_;  // Palette index -> window surface format
+    std::vector<uint32_t> frame32_;        // 32-bit frame for callers that produce RGB themselves
+    std::vector<uint32_t> rowBuffer_;      // One converted source row
+    std::vector<SDL_Rect> updateRects_;
+    int scale_;
+    int offsetX_, offsetY_;                // Centered output within the window
+    int surfaceWidth_, surfaceHeight_;
+    bool fullUpdate_;                      // Whole window must be redrawn (first frame, resize)
+
+public:
+    SoftwarePresenter(int sourceWidth, int sourceHeight);
+
+    // Check the window surface can be used (32-bit formats only)
+    bool init(SDL_Window* window);
+
+    // Colors as RGBA8888 values; converted to the window surface format
+    void setColors(const uint32_t* rgba8888);
+    const uint32_t* getColorTable() const { return colorTable_.data(); }
+
+    // Scale the given regions of the indexed frame into the window
+    bool present(const IndexedSurface& frame, const std::vector<Rect>& dirtyRects);
+
+    // Frame already converted to window surface colors (scanline mode)
+    uint32_t* getFrame32() { return frame32_.data(); }
+    int getFrame32Pitch() const { return sourceWidth_ * 4; }
+    bool presentFrame32();
+
+    void invalidate() { fullUpdate_ = true; }
+    int getScale() const { return scale_; }
+
+private:
+    SDL_Surface* beginFrame();
+    void fitToSurface(SDL_Surface* surface);
+    void endFrame(SDL_Surface* surface);
+    void clearSurface(SDL_Surface* surface);
+    void scaleRect(SDL_Surface* surface, const Rect& rect, const IndexedSurface* frame);
+    void pushRects(const std::vector<Rect>& rects);
+};
+
+} // namespace BattleCity
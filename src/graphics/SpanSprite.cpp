@@ -0,0 +1,84 @@
+#include "SpanSprite.h"
+#include <algorithm>
+#include <cstring>
+
+namespace BattleCity {
+
+SpanSprite::SpanSprite() : width_(0), height_(0) {
+}
+
+void SpanSprite::encode(const uint8_t* pixels, int width, int height, int pitch) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    rowStart_.assign(1, 0);
+    spans_.clear();
+    pixels_.clear();
+
+    for (int y = 0; y < height_; ++y) {
+        const uint8_t* row = pixels + static_cast<size_t>(y) * pitch;
+        int x = 0;
+        while (x < width_) {
+            // Skip the transparent run, then collect the opaque one
+            while (x < width_ && row[x] == 0) ++x;
+            int start = x;
+            while (x < width_ && row[x] != 0) ++x;
+            if (x > start) {
+                SpriteSpan span;
+                span.x = static_cast<uint16_t>(start);
+                span.length = static_cast<uint16_t>(x - start);
+                span.pixelOffset = static_cast<uint32_t>(pixels_.size());
+                spans_.push_back(span);
+                pixels_.insert(pixels_.end(), row + start, row + x);
+            }
+        }
+        rowStart_.push_back(static_cast<uint32_t>(spans_.size()));
+    }
+}
+
+void SpanSprite::draw(IndexedSurface& target, int x, int y) const {
+    drawSpans(target, x, y, [](uint8_t* dst, const uint8_t* src, int length) {
+        std::memcpy(dst, src, length);
+    });
+}
+
+void SpanSprite::drawSolid(IndexedSurface& target, int x, int y, uint8_t colorIndex) const {
+    drawSpans(target, x, y, [colorIndex](uint8_t* dst, const uint8_t*, int length) {
+        std::memset(dst, colorIndex, length);
+    });
+}
+
+void SpanSprite::drawRemapped(IndexedSurface& target, int x, int y, const uint8_t* remap) const {
+    drawSpans(target, x, y, [remap](uint8_t* dst, const uint8_t* src, int length) {
+        for (int i = 0; i < length; ++i) {
+            dst[i] = remap[src[i] & 0x3F];
+        }
+    });
+}
+
+template <typename CopySpan>
+void SpanSprite::drawSpans(IndexedSurface& target, int x, int y, CopySpan copySpan) const {
+    // Clip the sprite rectangle once
+    int firstRow = std::max(0, -y);
+    int lastRow = std::min(height_, target.getHeight() - y);
+    int clipLeft = std::max(0, -x);
+    int clipRight = std::min(width_, target.getWidth() - x);
+    if (firstRow >= lastRow || clipLeft >= clipRight) return;
+
+    bool unclipped = clipLeft == 0 && clipRight == width_;
+    for (int row = firstRow; row < lastRow; ++row) {
+        uint8_t* dst = target.getRow(y + row);
+        for (uint32_t i = rowStart_[row]; i < rowStart_[row + 1]; ++i) {
+            const SpriteSpan& span = spans_[i];
+            int start = span.x;
+            int end = span.x + span.length;
+            if (!unclipped) {
+                start = std::max(start, clipLeft);
+                end = std::min(end, clipRight);
+                if (start >= end) continue;
+            }
+            copySpan(dst + x + start, pixels_.data() + span.pixelOffset + (start - span.x), end - start);
+        }
+    }
+}
+
+} // namespace BattleCity
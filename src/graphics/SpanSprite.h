@@ -0,0 +1,51 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include <cstdint>
+#include <vector>
+
+namespace BattleCity {
+
+// Run of opaque pixels in one sprite row
+struct SpriteSpan {
+    uint16_t x;            // Start column
+    uint16_t length;
+    uint32_t pixelOffset;  // Into the packed opaque pixels
+};
+
+// Transparent sprite stored as opaque spans per row (index 0 = transparent).
+// Encoded once at load time; drawing clips once per sprite and copies each
+// visible span with memcpy, so transparent runs cost nothing.
+class SpanSprite {
+private:
+    int width_;
+    int height_;
+    std::vector<uint32_t> rowStart_;  // First span of each row, height + 1 entries
+    std::vector<SpriteSpan> spans_;
+    std::vector<uint8_t> pixels_;
+
+public:
+    SpanSprite();
+
+    // Encode width x height indexed pixels (rows pitch bytes apart)
+    void encode(const uint8_t* pixels, int width, int height, int pitch);
+
+    // Draw with the sprite's own colors
+    void draw(IndexedSurface& target, int x, int y) const;
+
+    // Draw every opaque pixel in one color (tinted placeholder patterns)
+    void drawSolid(IndexedSurface& target, int x, int y, uint8_t colorIndex) const;
+
+    // Draw with every color passed through a 64-entry remap table
+    void drawRemapped(IndexedSurface& target, int x, int y, const uint8_t* remap) const;
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getSpanCount() const { return static_cast<int>(spans_.size()); }
+
+private:
+    template <typename CopySpan>
+    void drawSpans(IndexedSurface& target, int x, int y, CopySpan copySpan) const;
+};
+
+} // namespace BattleCity
@@ -0,0 +1,326 @@
+#include "SpriteAtlas.h"
+#include "ImageLoader.h"
+#include "SpriteSheet.h"
+#include "Palette.h"
+#include "../utils/AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace BattleCity {
+
+namespace {
+
+// Sprite directories loaded into the atlas (relative to the sprite root)
+struct SpriteGroup {
+    const char* directory;
+    bool directional;  // Art faces up, store all four rotations
+    const char* sheet; // Pre-packed TexturePacker sheet used instead of the loose files
+};
+
+const SpriteGroup SPRITE_GROUPS[] = {
+    {"player/p1", true, "player/tp/p1.plist"},
+    {"player/p2", true, "player/tp/p2.plist"},
+    {"player/p3", true, nullptr},
+    {"player/p4", true, nullptr},
+    {"enemy", true, nullptr},
+    {"bullets", true, nullptr},
+    {"terrain", false, nullptr},
+    {"powerups", false, nullptr},
+    {"effects/boom/boom1", false, nullptr},
+    {"effects/boom/boom2", false, nullptr},
+    {"effects/born_shield", false, nullptr},
+    {"effects/river_shield", false, nullptr},
+    {"effects/star", false, nullptr},
+    {"ui", false, nullptr},
+};
+
+std::string stripExtension(const std::string& fileName) {
+    size_t dot = fileName.find_last_of('.');
+    return dot == std::string::npos ? fileName : fileName.substr(0, dot);
+}
+
+// Rotate an up-facing image into the given direction
+IndexedSurface rotateImage(const IndexedSurface& source, Direction direction) {
+    int w = source.getWidth();
+    int h = source.getHeight();
+
+    if (direction == Direction::DOWN) {
+        IndexedSurface result(w, h);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                result.getRow(y)[x] = source.getRow(h - 1 - y)[w - 1 - x];
+            }
+        }
+        return result;
+    }
+
+    if (direction == Direction::LEFT || direction == Direction::RIGHT) {
+        IndexedSurface result(h, w);
+        for (int y = 0; y < w; ++y) {
+            for (int x = 0; x < h; ++x) {
+                result.getRow(y)[x] = (direction == Direction::LEFT)
+                    ? source.getRow(x)[w - 1 - y]           // 90 degrees counter-clockwise
+                    : source.getRow(h - 1 - x)[y];          // 90 degrees clockwise
+            }
+        }
+        return result;
+    }
+
+    return source;
+}
+
+} // namespace
+
+SpriteAtlas::SpriteAtlas() : loaded_(false) {
+    resolveLookups();
+}
+
+bool SpriteAtlas::load(const std::string& spriteRoot, const Palette& palette) {
+    namespace fs = std::filesystem;
+
+    ImageLoader loader(palette);
+    std::vector<IndexedSurface> images;
+    std::vector<std::string> names;
+
+    rects_.clear();
+    spans_.clear();
+    names_.clear();
+    loaded_ = false;
+
+    auto addSprite = [&](const SpriteGroup& group, const std::string& stem, IndexedSurface image) {
+        names_[std::string(group.directory) + "/" + stem] = static_cast<SpriteId>(images.size());
+
+        if (group.directional) {
+            IndexedSurface down = rotateImage(image, Direction::DOWN);
+            IndexedSurface left = rotateImage(image, Direction::LEFT);
+            IndexedSurface right = rotateImage(image, Direction::RIGHT);
+            images.push_back(std::move(image));
+            images.push_back(std::move(down));
+            images.push_back(std::move(left));
+            images.push_back(std::move(right));
+        } else {
+            images.push_back(std::move(image));
+        }
+    };
+
+    for (const SpriteGroup& group : SPRITE_GROUPS) {
+        // A packed sheet replaces the loose files: one file open and one decode
+        if (group.sheet) {
+            SpriteSheet sheet;
+            if (sheet.load((fs::path(spriteRoot) / group.sheet).string(), loader)) {
+                std::vector<std::string> frameNames;
+                for (int i = 0; i < sheet.getFrameCount(); ++i) {
+                    frameNames.push_back(sheet.getFrame(i).name);
+                }
+                std::sort(frameNames.begin(), frameNames.end());
+
+                for (const std::string& frameName : frameNames) {
+                    IndexedSurface image;
+                    sheet.extractFrame(sheet.findFrame(frameName), image);
+                    addSprite(group, stripExtension(frameName), std::move(image));
+                }
+                continue;
+            }
+        }
+
+        fs::path directory = fs::path(spriteRoot) / group.directory;
+        std::error_code error;
+        if (!fs::is_directory(directory, error)) continue;
+
+        // Sorted so that sprite ids are stable between runs
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(directory, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".png") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const fs::path& file : files) {
+            IndexedSurface image;
+            if (!loader.loadPng(file.string(), image)) {
+                std::cerr << "SpriteAtlas: failed to decode " << file.string() << std::endl;
+                continue;
+            }
+
+            addSprite(group, file.stem().string(), std::move(image));
+        }
+    }
+
+    if (images.empty()) {
+        resolveLookups();
+        return false;
+    }
+
+    // Shelf packing: tallest images first, left to right, new shelf when full
+    std::vector<size_t> order(images.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+        return images[a].getHeight() > images[b].getHeight();
+    });
+
+    rects_.assign(images.size(), Rect());
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (size_t index : order) {
+        const IndexedSurface& image = images[index];
+        if (shelfX + image.getWidth() > ATLAS_WIDTH) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        rects_[index] = Rect(shelfX, shelfY, image.getWidth(), image.getHeight());
+        shelfX += image.getWidth();
+        shelfHeight = std::max(shelfHeight, image.getHeight());
+    }
+
+    surface_.resize(ATLAS_WIDTH, shelfY + shelfHeight);
+    for (size_t i = 0; i < images.size(); ++i) {
+        surface_.blit(images[i], images[i].getBounds(), rects_[i].x, rects_[i].y);
+    }
+
+    buildSpans();
+    resolveLookups();
+    loaded_ = true;
+    return true;
+}
+
+bool SpriteAtlas::loadPack(const AssetPack& pack) {
+    const PackEntry* pixels = pack.find("atlas/pixels");
+    const PackEntry* sprites = pack.find("atlas/sprites");
+    if (!pixels || !sprites || pixels->type != PackEntryType::INDEXED_IMAGE ||
+        pixels->size != static_cast<uint32_t>(pixels->width) * pixels->height) {
+        return false;
+    }
+
+    // Every record must be a non-empty rect inside the atlas and name a C
+    // string, or blits and span building would read past the pixels (and
+    // tiling a zero-size sprite never ends)
+    const PackSprite* records = reinterpret_cast<const PackSprite*>(pack.getData(*sprites));
+    size_t count = sprites->size / sizeof(PackSprite);
+    for (size_t i = 0; i < count; ++i) {
+        const PackSprite& record = records[i];
+        bool inside = record.x >= 0 && record.y >= 0 && record.w > 0 && record.h > 0 &&
+                      static_cast<int64_t>(record.x) + record.w <= pixels->width &&
+                      static_cast<int64_t>(record.y) + record.h <= pixels->height;
+        if (!inside || !std::memchr(record.name, '\0', sizeof(record.name))) {
+            std::cerr << "SpriteAtlas: sprite record " << i << " in the pack is invalid" << std::endl;
+            return false;
+        }
+    }
+
+    surface_ = IndexedSurface::view(pack.getData(*pixels), pixels->width, pixels->height);
+    rects_.resize(count);
+    names_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        rects_[i] = Rect(records[i].x, records[i].y, records[i].w, records[i].h);
+        if (records[i].name[0] != '\0') {
+            names_.emplace(records[i].name, static_cast<SpriteId>(i));
+        }
+    }
+
+    buildSpans();
+    resolveLookups();
+    loaded_ = count > 0;
+    return loaded_;
+}
+
+std::vector<std::string> SpriteAtlas::getSpriteNames() const {
+    std::vector<std::string> names(rects_.size());
+    for (const auto& entry : names_) {
+        names[entry.second] = entry.first;
+    }
+    return names;
+}
+
+SpriteId SpriteAtlas::find(const std::string& name) const {
+    auto it = names_.find(name);
+    return it != names_.end() ? it->second : INVALID_SPRITE;
+}
+
+SpriteId SpriteAtlas::getPlayerTank(int player, int level, Direction direction, int frame) const {
+    if (player < 0 || player >= PLAYER_COUNT) return INVALID_SPRITE;
+    level = std::clamp(level, 0, PLAYER_LEVELS - 1);
+    return directional(playerTanks_[player][level][frame & 1], direction);
+}
+
+SpriteId SpriteAtlas::getEnemyTank(EnemyType type, int variant, Direction direction, int frame) const {
+    int typeIndex = static_cast<int>(type);
+    if (typeIndex < 0 || typeIndex >= ENEMY_TYPES) return INVALID_SPRITE;
+    variant = std::clamp(variant, 0, ENEMY_VARIANTS - 1);
+    return directional(enemyTanks_[typeIndex][variant][frame & 1], direction);
+}
+
+SpriteId SpriteAtlas::getBullet(Direction direction) const {
+    return directional(bullet_, direction);
+}
+
+SpriteId SpriteAtlas::getPowerUp(PowerUpType type) const {
+    int index = static_cast<int>(type);
+    return (index >= 0 && index < POWERUP_TYPES) ? powerUps_[index] : INVALID_SPRITE;
+}
+
+void SpriteAtlas::resolveLookups() {
+    // Player art: player/p<player>/p<player>_<level>_<frame>
+    for (int player = 0; player < PLAYER_COUNT; ++player) {
+        for (int level = 0; level < PLAYER_LEVELS; ++level) {
+            for (int frame = 0; frame < ANIMATION_FRAMES; ++frame) {
+                std::string id = std::to_string(player + 1);
+                playerTanks_[player][level][frame] = find("player/p" + id + "/p" + id + "_" +
+                    std::to_string(level) + "_" + std::to_string(frame));
+            }
+        }
+    }
+
+    // Enemy art: enemy/e<n>_<variant>_<frame>. Variant 1 is the flashing bonus
+    // tank; the armored tank (e4) uses variants 0-3 for its remaining armor.
+    static const int ENEMY_ART[ENEMY_TYPES] = {
+        1,  // BASIC
+        2,  // FAST
+        4,  // HEAVY (armored)
+        3   // ELITE (power)
+    };
+    for (int type = 0; type < ENEMY_TYPES; ++type) {
+        for (int variant = 0; variant < ENEMY_VARIANTS; ++variant) {
+            for (int frame = 0; frame < ANIMATION_FRAMES; ++frame) {
+                SpriteId id = find("enemy/e" + std::to_string(ENEMY_ART[type]) + "_" +
+                                   std::to_string(variant) + "_" + std::to_string(frame));
+                // Types without extra variants fall back to their normal colors
+                enemyTanks_[type][variant][frame] = (id == INVALID_SPRITE && variant > 0)
+                    ? enemyTanks_[type][0][frame] : id;
+            }
+        }
+    }
+
+    // Power-up icons in PowerUpType order
+    static const char* POWERUP_ART[POWERUP_TYPES] = {
+        "powerups/prop5",  // TANK_UPGRADE (star)
+        "powerups/prop7",  // EXTRA_LIFE (tank)
+        "powerups/prop2",  // TIMER_BOMB (clock)
+        "powerups/prop6",  // SHIELD (helmet)
+        "powerups/prop1"   // CLEAR_ENEMIES (grenade)
+    };
+    for (int i = 0; i < POWERUP_TYPES; ++i) {
+        powerUps_[i] = find(POWERUP_ART[i]);
+    }
+
+    bullet_ = find("bullets/bullet");
+    base_ = find("terrain/base");
+    baseDestroyed_ = find("terrain/base_destroyed");
+}
+
+void SpriteAtlas::buildSpans() {
+    spans_.resize(rects_.size());
+    for (size_t i = 0; i < rects_.size(); ++i) {
+        const Rect& rect = rects_[i];
+        spans_[i].encode(surface_.getRow(rect.y) + rect.x, rect.w, rect.h, surface_.getPitch());
+    }
+}
+
+SpriteId SpriteAtlas::directional(SpriteId base, Direction direction) {
+    if (base == INVALID_SPRITE || direction == Direction::NONE) return base;
+    return base + static_cast<int>(direction);
+}
+
+} // namespace BattleCity
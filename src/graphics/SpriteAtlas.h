@@ -0,0 +1,89 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include "SpanSprite.h"
+#include "../gameplay/PowerUp.h"
+#include "../utils/MathUtils.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BattleCity {
+
+class Palette;
+class AssetPack;
+
+// Integer handle of a sprite stored in the atlas
+using SpriteId = int;
+constexpr SpriteId INVALID_SPRITE = -1;
+
+// Every PNG under assets/sprites decoded once at startup and packed into a
+// single palette-indexed atlas surface (index 0 = transparent).
+//
+// Sprite art for tanks and bullets faces up; for those groups the loader also
+// stores rotated copies so that the four directions occupy consecutive ids in
+// Direction order (UP, DOWN, LEFT, RIGHT).
+class SpriteAtlas {
+public:
+    static constexpr int ATLAS_WIDTH = 256;
+    static constexpr int PLAYER_COUNT = 4;      // p1..p4 color sets
+    static constexpr int PLAYER_LEVELS = 4;     // Upgrade levels 0-3
+    static constexpr int ENEMY_TYPES = 4;
+    static constexpr int ENEMY_VARIANTS = 4;    // Bonus flash / armor colors
+    static constexpr int ANIMATION_FRAMES = 2;
+    static constexpr int POWERUP_TYPES = 5;
+
+private:
+    IndexedSurface surface_;
+    std::vector<Rect> rects_;
+    std::vector<SpanSprite> spans_;  // Span-encoded copy of every sprite for drawing
+    std::unordered_map<std::string, SpriteId> names_;
+    bool loaded_;
+
+    // Typed lookup tables, resolved by name once loading is done
+    SpriteId playerTanks_[PLAYER_COUNT][PLAYER_LEVELS][ANIMATION_FRAMES];
+    SpriteId enemyTanks_[ENEMY_TYPES][ENEMY_VARIANTS][ANIMATION_FRAMES];
+    SpriteId powerUps_[POWERUP_TYPES];
+    SpriteId bullet_;
+    SpriteId base_;
+    SpriteId baseDestroyed_;
+
+public:
+    SpriteAtlas();
+
+    // Decode all sprites below spriteRoot and build the atlas
+    bool load(const std::string& spriteRoot, const Palette& palette);
+
+    // Use the baked atlas of an asset pack in place (pixels are not copied,
+    // the pack must stay open while the atlas is used)
+    bool loadPack(const AssetPack& pack);
+    bool isLoaded() const { return loaded_; }
+
+    // Lookup by name: path relative to the sprite root without extension,
+    // e.g. "terrain/terrain_brick". Returns INVALID_SPRITE if missing.
+    SpriteId find(const std::string& name) const;
+
+    // Typed lookups used by gameplay rendering
+    SpriteId getPlayerTank(int player, int level, Direction direction, int frame) const;
+    SpriteId getEnemyTank(EnemyType type, int variant, Direction direction, int frame) const;
+    SpriteId getBullet(Direction direction) const;
+    SpriteId getPowerUp(PowerUpType type) const;
+    SpriteId getBase(bool destroyed) const { return destroyed ? baseDestroyed_ : base_; }
+
+    // Atlas data
+    const IndexedSurface& getSurface() const { return surface_; }
+    const Rect& getRect(SpriteId id) const { return rects_[id]; }
+    const SpanSprite& getSpans(SpriteId id) const { return spans_[id]; }
+    bool isValid(SpriteId id) const { return id >= 0 && id < static_cast<int>(rects_.size()); }
+    int getSpriteCount() const { return static_cast<int>(rects_.size()); }
+
+    // Sprite names by id ("" for generated rotations), used by the asset baker
+    std::vector<std::string> getSpriteNames() const;
+
+private:
+    void resolveLookups();
+    void buildSpans();
+    static SpriteId directional(SpriteId base, Direction direction);
+};
+
+} // namespace BattleCity
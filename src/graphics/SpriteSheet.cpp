@@ -0,0 +1,85 @@
+#include "SpriteSheet.h"
+#include "ImageLoader.h"
+#include "../utils/FileUtils.h"
+#include <iostream>
+
+namespace BattleCity {
+
+bool SpriteSheet::load(const std::string& plistPath, ImageLoader& loader) {
+    frames_.clear();
+    frameHashes_.clear();
+    buckets_.clear();
+
+    std::string text = FileUtils::readTextFile(plistPath);
+    if (text.empty()) return false;
+
+    PlistFrameTable table;
+    if (!PlistParser::parseFrameTable(text, table) || table.textureFileName.empty()) {
+        std::cerr << "SpriteSheet: invalid frame table " << plistPath << std::endl;
+        return false;
+    }
+
+    size_t slash = plistPath.find_last_of("/\\");
+    std::string texturePath = (slash == std::string::npos)
+        ? table.textureFileName
+        : plistPath.substr(0, slash + 1) + table.textureFileName;
+    if (!loader.loadPng(texturePath, texture_)) {
+        std::cerr << "SpriteSheet: failed to decode " << texturePath << std::endl;
+        return false;
+    }
+
+    frames_ = std::move(table.frames);
+    buildLookup();
+    return true;
+}
+
+int SpriteSheet::findFrame(std::string_view name, uint32_t hash) const {
+    if (buckets_.empty()) return -1;
+
+    size_t mask = buckets_.size() - 1;
+    for (size_t slot = hash & mask; buckets_[slot] >= 0; slot = (slot + 1) & mask) {
+        int index = buckets_[slot];
+        if (frameHashes_[index] == hash && frames_[index].name == name) return index;
+    }
+    return -1;
+}
+
+void SpriteSheet::extractFrame(int index, IndexedSurface& image) const {
+    const PlistFrame& frame = frames_[index];
+    const Rect& rect = frame.textureRect;
+    image.resize(frame.sourceWidth, frame.sourceHeight);
+
+    // Trimmed frames sit at the source center plus the offset (offset y points up)
+    int left = (frame.sourceWidth - rect.w) / 2 + frame.offsetX;
+    int top = (frame.sourceHeight - rect.h) / 2 - frame.offsetY;
+
+    if (!frame.rotated) {
+        image.blit(texture_, rect, left, top);
+        return;
+    }
+
+    // Rotated frames occupy h x w in the sheet, turned 90 degrees clockwise
+    for (int y = 0; y < rect.h; ++y) {
+        for (int x = 0; x < rect.w; ++x) {
+            image.setPixel(left + x, top + y, texture_.getPixel(rect.x + rect.h - 1 - y, rect.y + x));
+        }
+    }
+}
+
+void SpriteSheet::buildLookup() {
+    // Keep the table at most half full so probe chains stay short
+    size_t bucketCount = 4;
+    while (bucketCount < frames_.size() * 2) bucketCount *= 2;
+    buckets_.assign(bucketCount, -1);
+
+    frameHashes_.resize(frames_.size());
+    size_t mask = bucketCount - 1;
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        frameHashes_[i] = hashName(frames_[i].name);
+        size_t slot = frameHashes_[i] & mask;
+        while (buckets_[slot] >= 0) slot = (slot + 1) & mask;
+        buckets_[slot] = static_cast<int>(i);
+    }
+}
+
+} // namespace BattleCity
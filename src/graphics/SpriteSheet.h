@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IndexedSurface.h"
+#include "../utils/PlistParser.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BattleCity {
+
+class ImageLoader;
+
+// A TexturePacker sheet: one decoded texture plus its frame table.
+// Frame names resolve through an open-addressing table keyed by the FNV-1a
+// hash of the name, built once at load time.
+class SpriteSheet {
+private:
+    IndexedSurface texture_;
+    std::vector<PlistFrame> frames_;
+    std::vector<uint32_t> frameHashes_;
+    std::vector<int> buckets_;  // Frame index or -1, size is a power of two
+
+public:
+    // Load the .plist and the texture it names (relative to the plist)
+    bool load(const std::string& plistPath, ImageLoader& loader);
+
+    // Frame index by name, -1 if missing
+    int findFrame(std::string_view name) const { return findFrame(name, hashName(name)); }
+    int findFrame(std::string_view name, uint32_t hash) const;
+
+    int getFrameCount() const { return static_cast<int>(frames_.size()); }
+    const PlistFrame& getFrame(int index) const { return frames_[index]; }
+    const IndexedSurface& getTexture() const { return texture_; }
+
+    // Copy a frame at its source size, undoing rotation and trimming
+    void extractFrame(int index, IndexedSurface& image) const;
+
+    // FNV-1a; constexpr so fixed frame names can be hashed at compile time
+    static constexpr uint32_t hashName(std::string_view name) {
+        uint32_t hash = 2166136261u;
+        for (char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
+
+private:
+    void buildLookup();
+};
+
+} // namespace BattleCity
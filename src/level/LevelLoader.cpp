@@ -0,0 +1,299 @@
+#include "LevelLoader.h"
+#include "../utils/FileUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace BattleCity {
+
+namespace {
+
+bool letterToEnemy(char letter, EnemyType& type) {
+    switch (letter) {
+        case 'B': type = EnemyType::BASIC; return true;
+        case 'F': type = EnemyType::FAST; return true;
+        case 'H': type = EnemyType::HEAVY; return true;
+        case 'E': type = EnemyType::ELITE; return true;
+        default: return false;
+    }
+}
+
+std::string trim(const std::string& line) {
+    size_t begin = line.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = line.find_last_not_of(" \t\r");
+    return line.substr(begin, end - begin + 1);
+}
+
+constexpr int TILE_PIXELS = BRICK_CELL_SIZE * BRICK_CELLS;
+constexpr const char* ENEMY_SPAWN_PREFIX = "enemy ";
+
+// A pixel position on a terrain of width x height tiles
+bool parsePosition(const std::string& line, size_t width, size_t height, int& x, int& y) {
+    char extra = 0;
+    return std::sscanf(line.c_str(), "%d , %d %c", &x, &y, &extra) == 2 &&
+           x >= 0 && x < static_cast<int>(width) * TILE_PIXELS &&
+           y >= 0 && y < static_cast<int>(height) * TILE_PIXELS;
+}
+
+// Size and modification time of the text file, used to detect stale caches
+bool sourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+    std::error_code error;
+    size = std::filesystem::file_size(path, error);
+    if (error) return false;
+    time = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    return !error;
+}
+
+} // namespace
+
+TerrainType LevelLoader::tileToTerrain(int value) {
+    switch (value) {
+        case 1: return TerrainType::BRICK;
+        case 2: return TerrainType::STEEL;
+        case 3: return TerrainType::WATER;
+        case 4: return TerrainType::BASE_BRICK;
+        case 5: return TerrainType::FOREST;
+        default: return TerrainType::GRASS;
+    }
+}
+
+int LevelLoader::terrainToTile(TerrainType terrain) {
+    switch (terrain) {
+        case TerrainType::BRICK: return 1;
+        case TerrainType::STEEL: return 2;
+        case TerrainType::WATER: return 3;
+        case TerrainType::BASE_BRICK: return 4;
+        case TerrainType::FOREST: return 5;
+        default: return 0;
+    }
+}
+
+std::string LevelLoader::levelPath(const std::string& directory, int level) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/level%02d.txt", level);
+    return directory + name;
+}
+
+int LevelLoader::countStageFiles(const std::string& directory, int maxStages) {
+    std::error_code error;
+    int count = 0;
+    while (count < maxStages) {
+        std::string path = levelPath(directory, count + 1);
+        if (!std::filesystem::exists(path, error) && !std::filesystem::exists(compiledPath(path), error)) break;
+        ++count;
+    }
+    return count;
+}
+
+int LevelLoader::getStageFile(int level, int fileCount) {
+    return fileCount > 0 ? (level - 1) % fileCount + 1 : 0;
+}
+
+std::string LevelLoader::compiledPath(const std::string& textPath) {
+    size_t dot = textPath.find_last_of('.');
+    return (dot == std::string::npos ? textPath : textPath.substr(0, dot)) + ".bin";
+}
+
+bool LevelLoader::load(const std::string& textPath, LevelData& level) {
+    std::string binaryPath = compiledPath(textPath);
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    bool hasSource = sourceStamp(textPath, sourceSize, sourceTime);
+
+    // Compiled file: one fixed-size read, no parsing
+    std::vector<uint8_t> data = FileUtils::readBinaryFile(binaryPath);
+    if (data.size() == sizeof(CompiledLevel)) {
+        CompiledLevel compiled;
+        std::memcpy(&compiled, data.data(), sizeof(compiled));
+        bool current = !hasSource || (compiled.sourceSize == sourceSize && compiled.sourceTime == sourceTime);
+        if (current && decompile(compiled, level)) {
+            return true;
+        }
+    }
+    if (!hasSource) return false;
+
+    std::string error;
+    if (!parse(FileUtils::readTextFile(textPath), level, error)) {
+        std::cerr << textPath << ": " << error << std::endl;
+        return false;
+    }
+
+    // Cache the result; a read-only install just parses every time
+    if (!isStandardSize(level)) return true;
+    CompiledLevel compiled;
+    compile(level, compiled);
+    compiled.sourceSize = sourceSize;
+    compiled.sourceTime = sourceTime;
+    std::vector<uint8_t> bytes(sizeof(compiled));
+    std::memcpy(bytes.data(), &compiled, sizeof(compiled));
+    FileUtils::writeBinaryFile(binaryPath, bytes);
+    return true;
+}
+
+bool LevelLoader::parse(const std::string& text, LevelData& level, std::string& error) {
+    std::vector<std::string> rows;
+    bool hasEnemies = false;
+    bool hasBase = false;
+    error.clear();
+    level.enemyPattern.clear();
+    level.playerSpawnPoints.clear();
+    level.enemySpawnPoints.clear();
+
+    std::istringstream stream(text);
+    std::string rawLine;
+    int lineNumber = 0;
+    while (std::getline(stream, rawLine)) {
+        ++lineNumber;
+        std::string line = trim(rawLine);
+        if (line.empty() || line[0] == '#') continue;
+        std::string where = "line " + std::to_string(lineNumber) + ": ";
+
+        // Sections come in a fixed order: terrain (rows of digits), enemies,
+        // base, players
+        if (!hasEnemies && std::isdigit(static_cast<unsigned char>(line[0]))) {
+            if (rows.empty() && (line.size() < LEVEL_TILES || line.size() > LEVEL_MAX_SIZE)) {
+                error = where + "terrain rows need " + std::to_string(LEVEL_TILES) + " to " +
+                        std::to_string(LEVEL_MAX_SIZE) + " tiles";
+                return false;
+            }
+            if (!rows.empty() && line.size() != rows[0].size()) {
+                error = where + "terrain rows need " + std::to_string(rows[0].size()) + " tiles like the first";
+                return false;
+            }
+            for (char tile : line) {
+                if (tile < '0' || tile > '0' + LEVEL_MAX_TILE) {
+                    error = where + "unknown tile '" + tile + "'";
+                    return false;
+                }
+            }
+            if (rows.size() == LEVEL_MAX_SIZE) {
+                error = where + "at most " + std::to_string(LEVEL_MAX_SIZE) + " terrain rows";
+                return false;
+            }
+            rows.push_back(line);
+        } else if (rows.size() < LEVEL_TILES) {
+            error = where + "expected at least " + std::to_string(LEVEL_TILES) + " terrain rows";
+            return false;
+        } else if (!hasEnemies) {
+            std::istringstream entries(line);
+            std::string entry;
+            while (std::getline(entries, entry, ',')) {
+                entry = trim(entry);
+                EnemyType type;
+                if (entry.size() != 1 || !letterToEnemy(entry[0], type)) {
+                    error = where + "unknown enemy '" + entry + "'";
+                    return false;
+                }
+                level.enemyPattern.push_back(type);
+            }
+            if (level.enemyPattern.size() != LEVEL_ENEMY_COUNT) {
+                error = where + "expected " + std::to_string(LEVEL_ENEMY_COUNT) + " enemies";
+                return false;
+            }
+            hasEnemies = true;
+        } else {
+            bool isEnemySpawn = line.compare(0, std::strlen(ENEMY_SPAWN_PREFIX), ENEMY_SPAWN_PREFIX) == 0;
+            if (isEnemySpawn) line = trim(line.substr(std::strlen(ENEMY_SPAWN_PREFIX)));
+            int x = 0, y = 0;
+            if (!parsePosition(line, rows[0].size(), rows.size(), x, y)) {
+                error = where + "expected an x,y position on the terrain";
+                return false;
+            }
+            if (isEnemySpawn) {
+                if (level.enemySpawnPoints.size() == LEVEL_MAX_ENEMY_SPAWNS) {
+                    error = where + "at most " + std::to_string(LEVEL_MAX_ENEMY_SPAWNS) + " enemy spawn points";
+                    return false;
+                }
+                level.enemySpawnPoints.push_back(Vector2::fromPixels(x, y));
+            } else if (!hasBase) {
+                level.basePosition = Vector2::fromPixels(x, y);
+                hasBase = true;
+            } else if (level.playerSpawnPoints.size() < LEVEL_MAX_PLAYERS) {
+                level.playerSpawnPoints.push_back(Vector2::fromPixels(x, y));
+            } else {
+                error = where + "at most " + std::to_string(LEVEL_MAX_PLAYERS) + " player positions";
+                return false;
+            }
+        }
+    }
+
+    if (rows.size() < LEVEL_TILES) {
+        error = "expected at least " + std::to_string(LEVEL_TILES) + " terrain rows";
+    } else if (!hasEnemies) {
+        error = "missing enemy list";
+    } else if (!hasBase) {
+        error = "missing base position";
+    } else if (level.playerSpawnPoints.empty()) {
+        error = "missing player position";
+    }
+    if (!error.empty()) return false;
+
+    level.terrain.resize(static_cast<int>(rows[0].size()), static_cast<int>(rows.size()));
+    for (size_t y = 0; y < rows.size(); ++y) {
+        for (size_t x = 0; x < rows[y].size(); ++x) {
+            level.terrain[static_cast<int>(y)][static_cast<int>(x)] = tileToTerrain(rows[y][x] - '0');
+        }
+    }
+    return true;
+}
+
+bool LevelLoader::isStandardSize(const LevelData& level) {
+    return level.terrain.getWidth() == LEVEL_TILES && level.terrain.getHeight() == LEVEL_TILES;
+}
+
+void LevelLoader::compile(const LevelData& level, CompiledLevel& compiled) {
+    std::memset(&compiled, 0, sizeof(compiled));
+    compiled.magic = LEVEL_MAGIC;
+    compiled.version = LEVEL_VERSION;
+
+    packTerrain(level.terrain, compiled.terrain);
+    for (int i = 0; i < LEVEL_ENEMY_COUNT && i < static_cast<int>(level.enemyPattern.size()); ++i) {
+        compiled.enemies[i / 4] |= static_cast<uint8_t>(static_cast<int>(level.enemyPattern[i]) << ((i % 4) * 2));
+    }
+
+    compiled.baseX = static_cast<uint16_t>(level.basePosition.pixelX());
+    compiled.baseY = static_cast<uint16_t>(level.basePosition.pixelY());
+    compiled.playerCount = static_cast<uint8_t>(std::min<size_t>(level.playerSpawnPoints.size(), LEVEL_MAX_PLAYERS));
+    for (int i = 0; i < compiled.playerCount; ++i) {
+        compiled.players[i][0] = static_cast<uint16_t>(level.playerSpawnPoints[i].pixelX());
+        compiled.players[i][1] = static_cast<uint16_t>(level.playerSpawnPoints[i].pixelY());
+    }
+    compiled.enemySpawnCount =
+        static_cast<uint8_t>(std::min<size_t>(level.enemySpawnPoints.size(), LEVEL_MAX_ENEMY_SPAWNS));
+    for (int i = 0; i < compiled.enemySpawnCount; ++i) {
+        compiled.enemySpawns[i][0] = static_cast<uint16_t>(level.enemySpawnPoints[i].pixelX());
+        compiled.enemySpawns[i][1] = static_cast<uint16_t>(level.enemySpawnPoints[i].pixelY());
+    }
+}
+
+bool LevelLoader::decompile(const CompiledLevel& compiled, LevelData& level) {
+    if (compiled.magic != LEVEL_MAGIC || compiled.version != LEVEL_VERSION) return false;
+    if (compiled.playerCount == 0 || compiled.playerCount > LEVEL_MAX_PLAYERS) return false;
+    if (compiled.enemySpawnCount > LEVEL_MAX_ENEMY_SPAWNS) return false;
+
+    level.terrain.resize(LEVEL_TILES, LEVEL_TILES);
+    if (!unpackTerrain(compiled.terrain, level.terrain)) return false;
+
+    level.enemyPattern.resize(LEVEL_ENEMY_COUNT);
+    for (int i = 0; i < LEVEL_ENEMY_COUNT; ++i) {
+        level.enemyPattern[i] = static_cast<EnemyType>((compiled.enemies[i / 4] >> ((i % 4) * 2)) & 0x03);
+    }
+
+    level.basePosition = Vector2::fromPixels(compiled.baseX, compiled.baseY);
+    level.playerSpawnPoints.clear();
+    for (int i = 0; i < compiled.playerCount; ++i) {
+        level.playerSpawnPoints.push_back(Vector2::fromPixels(compiled.players[i][0], compiled.players[i][1]));
+    }
+    level.enemySpawnPoints.clear();
+    for (int i = 0; i < compiled.enemySpawnCount; ++i) {
+        level.enemySpawnPoints.push_back(Vector2::fromPixels(compiled.enemySpawns[i][0], compiled.enemySpawns[i][1]));
+    }
+    return true;
+}
+
+} // namespace BattleCity
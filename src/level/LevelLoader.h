@@ -0,0 +1,85 @@
+#pragma once
+
+#include "LevelManager.h"
+#include <cstdint>
+#include <string>
+
+namespace BattleCity {
+
+// Compiled level (levelNN.bin, written next to levelNN.txt). A fixed-size
+// record that is read in one go; the source stamp tells whether the text
+// file changed since it was compiled. Only standard 13x13 stages are
+// compiled, larger arenas are parsed each time.
+constexpr uint32_t LEVEL_MAGIC = 0x564C4342;  // "BCLV"
+constexpr uint32_t LEVEL_VERSION = 3;
+constexpr int LEVEL_TILES = 13;          // Standard stage size
+constexpr int LEVEL_MAX_SIZE = TerrainGrid::MAX_TILES;  // Custom arenas
+constexpr int LEVEL_MAX_PLAYERS = 2;
+constexpr int LEVEL_MAX_ENEMY_SPAWNS = 8;
+constexpr int LEVEL_MAX_TILE = 5;         // Highest tile value (forest)
+
+struct CompiledLevel {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceSize;       // Text file size and modification time
+    int64_t sourceTime;
+    uint8_t terrain[getPackedTerrainSize(LEVEL_TILES, LEVEL_TILES)];  // See packTerrain
+    uint8_t enemies[LEVEL_ENEMY_COUNT / 4];  // EnemyType, four per byte (low bits first)
+    uint8_t playerCount;
+    uint8_t enemySpawnCount;   // 0: the default spawn points
+    uint16_t baseX, baseY;     // Pixels
+    uint16_t players[LEVEL_MAX_PLAYERS][2];
+    uint16_t enemySpawns[LEVEL_MAX_ENEMY_SPAWNS][2];
+};
+
+static_assert(sizeof(CompiledLevel) == 144, "CompiledLevel layout");
+
+// Loads stage files from assets/levels (or a custom pack directory).
+//
+// Text format, '#' starts a comment line:
+//   13 rows of 13 tile digits (0=floor, 1=brick, 2=steel, 3=water,
+//   4=base brick, 5=forest; arenas may use up to 512 rows of up to 512
+//   tiles, all rows the same length), then the 20 enemies in spawn order
+//   (B=BASIC, F=FAST, H=HEAVY, E=ELITE, comma separated), then the base
+//   position and one or two player spawn positions as "x,y" pixels.
+//   Optional "enemy x,y" lines (up to 8) give the enemy spawn points,
+//   otherwise the game's defaults are used. Positions must lie on the
+//   terrain.
+class LevelLoader {
+public:
+    // Path of a stage file, e.g. assets/levels/level01.txt
+    static std::string levelPath(const std::string& directory, int level);
+
+    // Stage files in directory (text or compiled), stopping at the first
+    // missing number or at maxStages
+    static int countStageFiles(const std::string& directory, int maxStages);
+
+    // Stages past the last stage file replay the files in order. A replayed
+    // stage keeps the file's layout but not its spawn list, so its enemies
+    // follow the default order of its own stage range.
+    static int getStageFile(int level, int fileCount);  // 1-based, 0 without files
+    static bool isReplayedStage(int level, int fileCount) { return level > fileCount; }
+
+    // Load a stage. Uses the compiled file when it is up to date (or when
+    // only the compiled file exists), otherwise parses the text and writes
+    // the compiled file for next time.
+    static bool load(const std::string& textPath, LevelData& level);
+
+    // Parse and validate the text format; errors name the offending line
+    static bool parse(const std::string& text, LevelData& level, std::string& error);
+
+    // Only 13x13 stages fit the compiled and packed formats
+    static bool isStandardSize(const LevelData& level);
+
+    static void compile(const LevelData& level, CompiledLevel& compiled);
+    static bool decompile(const CompiledLevel& compiled, LevelData& level);
+
+    // Tile values used by the text and binary formats
+    static TerrainType tileToTerrain(int value);
+    static int terrainToTile(TerrainType terrain);
+
+private:
+    static std::string compiledPath(const std::string& textPath);
+};
+
+} // namespace BattleCity
@@ -1,25 +1,148 @@
 #include "LevelManager.h"
+#include "LevelLoader.h"
+#include "LevelPack.h"
 #include "../graphics/Renderer.h"
 #include "../graphics/Palette.h"
 #include <algorithm>
 
 namespace BattleCity {
 
+namespace {
+
+constexpr int TILE_PIXELS = BRICK_CELL_SIZE * BRICK_CELLS;
+constexpr int SCREEN_WIDTH = 256;
+constexpr int SCREEN_HEIGHT = 224;
+
+// SPANS[first][last]: the cells of rows (or columns) first..last of a tile
+constexpr std::array<std::array<uint16_t, BRICK_CELLS>, BRICK_CELLS> makeSpans(uint16_t line, int shift) {
+    std::array<std::array<uint16_t, BRICK_CELLS>, BRICK_CELLS> spans = {};
+    for (int first = 0; first < BRICK_CELLS; ++first) {
+        uint16_t bits = 0;
+        for (int last = first; last < BRICK_CELLS; ++last) {
+            bits = static_cast<uint16_t>(bits | (line << (last * shift)));
+            spans[first][last] = bits;
+        }
+    }
+    return spans;
+}
+
+constexpr auto ROW_SPANS = makeSpans(0x000F, BRICK_CELLS);
+constexpr auto COLUMN_SPANS = makeSpans(0x1111, 1);
+
+bool isBrick(TerrainType terrain) {
+    return hasTerrainFlag(terrain, TERRAIN_DESTRUCTIBLE);
+}
+
+// Rounds toward negative infinity, so pixels left of or above the field
+// land in negative tiles
+int floorDiv(int pixel, int size) {
+    return pixel >= 0 ? pixel / size : (pixel - size + 1) / size;
+}
+
+int tileOf(int pixel) {
+    return floorDiv(pixel, TILE_PIXELS);
+}
+
+// Cells of tile (tileX, tileY) overlapped by the pixel box [x0, x1] x [y0, y1]
+uint16_t cellsInArea(int tileX, int tileY, int x0, int y0, int x1, int y1) {
+    int left = std::max(x0 - tileX * TILE_PIXELS, 0) / BRICK_CELL_SIZE;
+    int right = std::min(x1 - tileX * TILE_PIXELS, TILE_PIXELS - 1) / BRICK_CELL_SIZE;
+    int top = std::max(y0 - tileY * TILE_PIXELS, 0) / BRICK_CELL_SIZE;
+    int bottom = std::min(y1 - tileY * TILE_PIXELS, TILE_PIXELS - 1) / BRICK_CELL_SIZE;
+    return ROW_SPANS[top][bottom] & COLUMN_SPANS[left][right];
+}
+
+void resetBrickMasks(LevelData& data) {
+    data.brickMasks.resize(data.terrain.getWidth(), data.terrain.getHeight());
+    for (int y = 0; y < data.terrain.getHeight(); ++y) {
+        for (int x = 0; x < data.terrain.getWidth(); ++x) {
+            data.brickMasks[y][x] = isBrick(data.terrain[y][x]) ? FULL_BRICK_MASK : 0;
+        }
+    }
+}
+
+} // namespace
+
 LevelManager::LevelManager(Random& random)
-    : currentLevel_(1), random_(random), enemiesRemaining_(20), enemiesToSpawn_(20),
-      spawnTimer_(48), spawnIndex_(0), enemySpawnCallback_(nullptr) {
-    // First enemy spawns after 800ms = 48 frames at 60fps
+    : currentLevel_(1), random_(random), enemiesRemaining_(LEVEL_ENEMY_COUNT),
+      spawnIndex_(0), spawnFrame_(0), animationFrame_(0), enemySpawnCallback_(nullptr),
+      levelPack_(std::make_unique<LevelPack>()), levelDirectory_("assets/levels"), levelFileCount_(0),
+      preloadLevel_(0), terrainCacheSequence_(0) {
+    // The baked pack holds every stage. Without one, or when a stage file
+    // was edited or added since it was baked, the stage files are read.
+    std::string packPath = std::string("assets/") + LEVEL_PACK_FILE_NAME;
+    if (levelPack_->open(packPath) && levelPack_->isOlderThan(packPath, levelDirectory_)) {
+        levelPack_->close();
+    }
+    levelFileCount_ = countStages();
+
     loadLevel(1);
 }
 
+LevelManager::~LevelManager() {
+    // The worker reads the pack and settings owned here
+    cancelPreload();
+}
+
 void LevelManager::loadLevel(int level) {
     currentLevel_ = std::clamp(level, 1, MAX_LEVELS);
-    enemiesRemaining_ = 20;
-    enemiesToSpawn_ = 20;
-    spawnTimer_ = 48; // First enemy spawns after 800ms = 48 frames at 60fps
+    enemiesRemaining_ = LEVEL_ENEMY_COUNT;
     spawnIndex_ = 0;
+    spawnFrame_ = 0;
+
+    // A stage prepared by preloadLevel() is swapped in, anything else is
+    // loaded now
+    std::unique_ptr<PreparedStage> prepared = takePreloaded(currentLevel_);
+    if (prepared) {
+        currentLevelData_ = std::move(prepared->data);
+        terrainCache_.replaceWith(std::move(prepared->terrain));
+    } else {
+        generateLevelData(currentLevel_);
+    }
 
-    generateLevelData(currentLevel_);
+    // Journal readers rebuild from the new stage; the render cache is
+    // already rebuilt or invalidated above
+    terrainJournal_.reset();
+    terrainCacheSequence_ = terrainJournal_.getHead();
+}
+
+void LevelManager::preloadLevel(int level, const SpriteAtlas& atlas) {
+    level = std::clamp(level, 1, MAX_LEVELS);
+    if (preload_.valid() && preloadLevel_ == level) return;
+    cancelPreload();
+
+    preloadLevel_ = level;
+    preload_ = std::async(std::launch::async, [this, level, &atlas] {
+        auto stage = std::make_unique<PreparedStage>();
+        stage->level = level;
+        buildLevelData(level, stage->data);
+
+        // Large arenas rasterize their chunks as they come into view
+        const TerrainGrid& terrain = stage->data.terrain;
+        if (terrain.getChunksX() * terrain.getChunksY() == 1) {
+            stage->terrain.update(stage->data, atlas);
+        }
+        return stage;
+    });
+}
+
+void LevelManager::cancelPreload() {
+    if (preload_.valid()) {
+        preload_.get();
+    }
+    preloadLevel_ = 0;
+}
+
+std::unique_ptr<LevelManager::PreparedStage> LevelManager::takePreloaded(int level) {
+    if (!preload_.valid() || preloadLevel_ != level) {
+        cancelPreload();
+        return nullptr;
+    }
+
+    // Normally long finished; otherwise waiting still beats loading again
+    std::unique_ptr<PreparedStage> stage = preload_.get();
+    preloadLevel_ = 0;
+    return stage;
 }
 
 void LevelManager::update(bool isPlaying) {
@@ -28,21 +151,37 @@ void LevelManager::update(bool isPlaying) {
         return;
     }
 
-    // Handle enemy spawning
-    if (enemiesToSpawn_ > 0 && spawnTimer_ <= 0) {
+    ++animationFrame_;
+
+    // Enemies appear on the frames the stage's schedule says
+    const SpawnSchedule& schedule = currentLevelData_.spawnSchedule;
+    while (spawnIndex_ < LEVEL_ENEMY_COUNT && schedule[spawnIndex_].frame <= spawnFrame_) {
         spawnNextEnemy();
-        enemiesToSpawn_--;
-        spawnTimer_ = getSpawnInterval();
     }
-
-    spawnTimer_--;
+    ++spawnFrame_;
 }
 
 void LevelManager::reset() {
-    enemiesRemaining_ = 20;
-    enemiesToSpawn_ = 20;
-    spawnTimer_ = 48; // First enemy spawns after 800ms = 48 frames
+    enemiesRemaining_ = LEVEL_ENEMY_COUNT;
     spawnIndex_ = 0;
+    spawnFrame_ = 0;
+}
+
+void LevelManager::setLevelDirectory(const std::string& directory) {
+    cancelPreload();
+    levelPack_->close();
+    levelDirectory_ = directory;
+    levelFileCount_ = countStages();
+    loadLevel(currentLevel_);
+}
+
+bool LevelManager::setLevelPack(const std::string& path) {
+    cancelPreload();
+    bool opened = levelPack_->open(path);
+    levelFileCount_ = countStages();
+    if (!opened) return false;
+    loadLevel(currentLevel_);
+    return true;
 }
 
 TerrainType LevelManager::getTerrain(int x, int y) const {
@@ -53,29 +192,99 @@ TerrainType LevelManager::getTerrain(int x, int y) const {
 }
 
 bool LevelManager::isBlocked(int x, int y, bool isBullet) const {
-    TerrainType terrain = getTerrain(x, y);
-
-    switch (terrain) {
-        case TerrainType::GRASS:
-            return false;
-        case TerrainType::BRICK:
-            return true;
-        case TerrainType::STEEL:
-            return true;
-        case TerrainType::WATER:
-            return !isBullet; // Bullets pass through water
-        case TerrainType::BASE_BRICK:
-            return true;
-        default:
-            return false;
+    // Bullets test the bit next to the tanks' one: water only stops tanks
+    uint8_t flag = static_cast<uint8_t>(TERRAIN_BLOCKS_TANKS << static_cast<int>(isBullet));
+    return (getTerrainFlags(getTerrain(x, y)) & flag) != 0;
+}
+
+Rect LevelManager::getWorldBounds() const {
+    return Rect(0, 0, std::max(currentLevelData_.terrain.getWidth() * TILE_PIXELS, SCREEN_WIDTH),
+                std::max(currentLevelData_.terrain.getHeight() * TILE_PIXELS, SCREEN_HEIGHT));
+}
+
+TerrainType LevelManager::getTerrainAtPixel(int pixelX, int pixelY) const {
+    int tileX = tileOf(pixelX);
+    int tileY = tileOf(pixelY);
+    TerrainType terrain = getTerrain(tileX, tileY);
+    if (!isBrick(terrain)) return terrain;
+
+    int cellX = (pixelX - tileX * TILE_PIXELS) / BRICK_CELL_SIZE;
+    int cellY = (pixelY - tileY * TILE_PIXELS) / BRICK_CELL_SIZE;
+    uint16_t cell = static_cast<uint16_t>(1u << (cellY * BRICK_CELLS + cellX));
+    return (currentLevelData_.brickMasks[tileY][tileX] & cell) ? terrain : TerrainType::GRASS;
+}
+
+bool LevelManager::isAreaBlocked(const Rect& area, bool isBullet) const {
+    if (area.w <= 0 || area.h <= 0) return false;
+
+    int x1 = area.x + area.w - 1;
+    int y1 = area.y + area.h - 1;
+    for (int tileY = tileOf(area.y); tileY <= tileOf(y1); ++tileY) {
+        for (int tileX = tileOf(area.x); tileX <= tileOf(x1); ++tileX) {
+            if (!isValidTerrainPosition(tileX, tileY)) return true;
+            if (!isBrick(currentLevelData_.terrain[tileY][tileX])) {
+                if (isBlocked(tileX, tileY, isBullet)) return true;
+                continue;
+            }
+            uint16_t cells = cellsInArea(tileX, tileY, area.x, area.y, x1, y1);
+            if (currentLevelData_.brickMasks[tileY][tileX] & cells) return true;
+        }
     }
+    return false;
 }
 
-void LevelManager::destroyBrick(int x, int y) {
-    if (isValidTerrainPosition(x, y) &&
-        currentLevelData_.terrain[y][x] == TerrainType::BRICK) {
-        currentLevelData_.terrain[y][x] = TerrainType::GRASS;
+bool LevelManager::damageBricks(int pixelX, int pixelY, Direction direction, int power) {
+    // Snap the impact to its cell, then span 8 pixels across the path and
+    // one or two cells along it
+    int depth = power >= 2 ? 2 : 1;
+    int cellX = floorDiv(pixelX, BRICK_CELL_SIZE) * BRICK_CELL_SIZE;
+    int cellY = floorDiv(pixelY, BRICK_CELL_SIZE) * BRICK_CELL_SIZE;
+    int x0, y0, x1, y1;
+    switch (direction) {
+        case Direction::UP:
+        case Direction::DOWN:
+            x0 = pixelX - BRICK_CELL_SIZE;
+            x1 = pixelX + BRICK_CELL_SIZE - 1;
+            y0 = direction == Direction::UP ? cellY - (depth - 1) * BRICK_CELL_SIZE : cellY;
+            y1 = y0 + depth * BRICK_CELL_SIZE - 1;
+            break;
+        case Direction::LEFT:
+        case Direction::RIGHT:
+            y0 = pixelY - BRICK_CELL_SIZE;
+            y1 = pixelY + BRICK_CELL_SIZE - 1;
+            x0 = direction == Direction::LEFT ? cellX - (depth - 1) * BRICK_CELL_SIZE : cellX;
+            x1 = x0 + depth * BRICK_CELL_SIZE - 1;
+            break;
+        default:
+            x0 = x1 = pixelX;
+            y0 = y1 = pixelY;
+            break;
+    }
+
+    bool destroyed = false;
+    for (int tileY = tileOf(y0); tileY <= tileOf(y1); ++tileY) {
+        for (int tileX = tileOf(x0); tileX <= tileOf(x1); ++tileX) {
+            if (!isValidTerrainPosition(tileX, tileY) || !isBrick(currentLevelData_.terrain[tileY][tileX])) continue;
+            destroyed |= clearBrickCells(tileX, tileY, cellsInArea(tileX, tileY, x0, y0, x1, y1)) != 0;
+        }
     }
+    return destroyed;
+}
+
+uint16_t LevelManager::clearBrickCells(int tileX, int tileY, uint16_t cells) {
+    uint16_t mask = currentLevelData_.brickMasks[tileY][tileX];
+    uint16_t cleared = mask & cells;
+    if (cleared == 0) return 0;
+
+    uint16_t remaining = static_cast<uint16_t>(mask & ~cells);
+    setTile(tileX, tileY, remaining ? currentLevelData_.terrain[tileY][tileX] : TerrainType::GRASS, remaining);
+    return cleared;
+}
+
+void LevelManager::setTile(int x, int y, TerrainType terrain, uint16_t brickMask) {
+    currentLevelData_.terrain[y][x] = terrain;
+    currentLevelData_.brickMasks[y][x] = brickMask;
+    terrainJournal_.record(x, y, terrain, brickMask);
 }
 
 void LevelManager::rebuildBaseBricks() {
@@ -86,217 +295,86 @@ void LevelManager::rebuildBaseBricks() {
     // Rebuild base bricks (simplified - would need actual base brick positions)
     for (int y = baseY - 1; y <= baseY + 1; ++y) {
         for (int x = baseX - 1; x <= baseX + 1; ++x) {
-            if (isValidTerrainPosition(x, y) &&
-                currentLevelData_.terrain[y][x] == TerrainType::GRASS) {
-                currentLevelData_.terrain[y][x] = TerrainType::BASE_BRICK;
+            if (!isValidTerrainPosition(x, y)) continue;
+            TerrainType terrain = currentLevelData_.terrain[y][x];
+            uint16_t mask = currentLevelData_.brickMasks[y][x];
+            if (terrain == TerrainType::GRASS ||
+                (terrain == TerrainType::BASE_BRICK && mask != FULL_BRICK_MASK)) {
+                setTile(x, y, TerrainType::BASE_BRICK, FULL_BRICK_MASK);
             }
         }
     }
 }
 
 void LevelManager::generateLevelData(int level) {
-    currentLevelData_.levelNumber = level;
+    buildLevelData(level, currentLevelData_);
 
-    // Initialize terrain to grass
-    for (auto& row : currentLevelData_.terrain) {
-        row.fill(TerrainType::GRASS);
-    }
-
-    // Add boundary walls
-    for (int i = 0; i < 13; ++i) {
-        currentLevelData_.terrain[0][i] = TerrainType::STEEL;
-        currentLevelData_.terrain[12][i] = TerrainType::STEEL;
-        currentLevelData_.terrain[i][0] = TerrainType::STEEL;
-        currentLevelData_.terrain[i][12] = TerrainType::STEEL;
-    }
+    // Whole terrain layer must be re-rasterized for the new level
+    terrainCache_.invalidateAll();
+}
 
-    // Load specific level terrain
-    loadTerrainData(level);
-
-    // Setup spawn points
-    setupSpawnPoints();
-
-    // Adjust base position for specific levels
-    adjustBasePositionForLevel(level);
-}
-
-void LevelManager::loadTerrainData(int level) {
-    // Load terrain data from configuration (using fake data for levels 1-5)
-    // For simplicity, use uncompressed format: each byte represents one tile
-    // 0=GRASS, 1=BRICK, 2=STEEL, 3=WATER, 4=BASE_BRICK
-    // 13x13 = 169 tiles = 169 bytes
-
-    const uint8_t* data = nullptr;
-    size_t dataSize = 0;
-
-    // Level 1: Simple cross pattern with base protection
-    static const uint8_t level1Data[169] = {
-        2,2,2,2,2,2,2,2,2,2,2,2,2,  // Row 0: Steel boundary
-        2,0,0,0,0,0,0,0,0,0,0,0,2,  // Row 1
-        2,0,1,1,1,0,1,1,1,0,1,1,2,  // Row 2
-        2,0,1,0,0,0,0,0,0,0,0,1,2,  // Row 3
-        2,0,1,0,2,2,0,2,2,0,2,1,2,  // Row 4
-        2,0,1,0,2,0,0,2,0,0,2,1,2,  // Row 5
-        2,0,1,0,2,2,0,2,2,0,2,1,2,  // Row 6
-        2,0,1,0,0,0,0,0,0,0,0,1,2,  // Row 7
-        2,0,1,1,1,0,1,1,1,0,1,1,2,  // Row 8
-        2,0,0,0,0,0,0,0,0,0,0,0,2,  // Row 9
-        2,1,1,1,0,0,0,1,1,1,1,1,2,  // Row 10
-        2,0,0,0,0,0,0,0,0,0,0,0,2,  // Row 11
-        2,2,2,2,2,2,2,2,2,2,2,2,2   // Row 12
-    };
+void LevelManager::buildLevelData(int level, LevelData& data) const {
+    data.levelNumber = level;
 
-    // Level 2-5: Use same pattern as level 1 for now (can be expanded later)
-    static const uint8_t level2Data[169] = {
-        2,2,2,2,2,2,2,2,2,2,2,2,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,0,1,1,1,1,1,1,1,1,1,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,0,3,3,3,0,0,3,3,1,2,
-        2,0,1,0,3,3,3,0,0,3,3,1,2,
-        2,0,1,0,3,3,3,0,0,3,3,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,1,1,1,1,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,1,1,1,0,0,0,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,2,2,2,2,2,2,2,2,2,2,2,2
-    };
+    // Setup spawn points (stage files may override the player positions)
+    setupSpawnPoints(data);
 
-    static const uint8_t level3Data[169] = {
-        2,2,2,2,2,2,2,2,2,2,2,2,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,0,1,1,1,1,1,1,1,1,1,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,0,1,1,1,0,1,1,1,1,2,
-        2,0,1,0,1,1,1,0,1,1,1,1,2,
-        2,0,1,0,1,1,1,0,1,1,1,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,1,1,1,1,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,1,1,1,0,0,0,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,2,2,2,2,2,2,2,2,2,2,2,2
-    };
-
-    // Level 4: Same as level 1 for now
-    static const uint8_t level4Data[169] = {
-        2,2,2,2,2,2,2,2,2,2,2,2,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,0,1,1,1,0,1,1,1,0,1,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,0,2,2,0,2,2,0,2,1,2,
-        2,0,1,0,2,0,0,2,0,0,2,1,2,
-        2,0,1,0,2,2,0,2,2,0,2,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,1,1,0,1,1,1,0,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,1,1,1,0,0,0,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,2,2,2,2,2,2,2,2,2,2,2,2
-    };
+    if (!loadLevelFile(level, data)) {
+        generateFallbackTerrain(data);
+        adjustBasePositionForLevel(level, data);
+        data.enemyPattern.clear();
+    } else if (LevelLoader::isReplayedStage(level, levelFileCount_)) {
+        // The file belongs to an earlier stage; enemies and base follow this one
+        adjustBasePositionForLevel(level, data);
+        data.enemyPattern.clear();
+    }
+    resetBrickMasks(data);
+    data.spawnSchedule = buildSpawnSchedule(level, data.enemyPattern, static_cast<int>(data.enemySpawnPoints.size()));
+}
 
-    // Level 5: Same as level 1 for now
-    static const uint8_t level5Data[169] = {
-        2,2,2,2,2,2,2,2,2,2,2,2,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,0,1,1,1,0,1,1,1,0,1,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,0,2,2,0,2,2,0,2,1,2,
-        2,0,1,0,2,0,0,2,0,0,2,1,2,
-        2,0,1,0,2,2,0,2,2,0,2,1,2,
-        2,0,1,0,0,0,0,0,0,0,0,1,2,
-        2,0,1,1,1,0,1,1,1,0,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,1,1,1,0,0,0,1,1,1,1,1,2,
-        2,0,0,0,0,0,0,0,0,0,0,0,2,
-        2,2,2,2,2,2,2,2,2,2,2,2,2
-    };
+bool LevelManager::loadLevelFile(int level, LevelData& data) const {
+    if (levelFileCount_ == 0) return false;
+
+    // Stages past the last one repeat the existing ones in order. Stages
+    // the pack doesn't hold (custom arena sizes) are read from their file.
+    int stage = LevelLoader::getStageFile(level, levelFileCount_);
+    LevelData loaded = data;
+    bool ok = levelPack_->hasStage(stage) ? levelPack_->loadStage(stage, loaded)
+                                          : LevelLoader::load(LevelLoader::levelPath(levelDirectory_, stage), loaded);
+    if (!ok) return false;
+
+    // Stages that don't declare enemy spawn points use the default ones
+    if (loaded.enemySpawnPoints.empty()) loaded.enemySpawnPoints = data.enemySpawnPoints;
+    data = std::move(loaded);
+    return true;
+}
 
-    // Select data based on level
-    switch (level) {
-        case 1:
-            data = level1Data;
-            dataSize = sizeof(level1Data);
-            break;
-        case 2:
-            data = level2Data;
-            dataSize = sizeof(level2Data);
-            break;
-        case 3:
-            data = level3Data;
-            dataSize = sizeof(level3Data);
-            break;
-        case 4:
-            data = level4Data;
-            dataSize = sizeof(level4Data);
-            break;
-        case 5:
-            data = level5Data;
-            dataSize = sizeof(level5Data);
-            break;
-        default:
-            // For levels > 5, use level 1 data as fallback
-            data = level1Data;
-            dataSize = sizeof(level1Data);
-            break;
-    }
+int LevelManager::countStages() const {
+    if (levelPack_->isOpen()) return levelPack_->getStageCount();
+    return LevelLoader::countStageFiles(levelDirectory_, MAX_LEVELS);
+}
 
-    // Decode uncompressed data (1 tile per byte)
-    if (data && dataSize >= 169) {
-        for (int y = 0; y < 13; ++y) {
-            for (int x = 0; x < 13; ++x) {
-                int index = y * 13 + x;
-                
-                // Check bounds
-                if (index >= static_cast<int>(dataSize)) {
-                    currentLevelData_.terrain[y][x] = TerrainType::GRASS;
-                    continue;
-                }
-                
-                uint8_t tileValue = data[index];
-
-                // Convert byte value to TerrainType
-                TerrainType terrainType;
-                switch (tileValue) {
-                    case 0: terrainType = TerrainType::GRASS; break;
-                    case 1: terrainType = TerrainType::BRICK; break;
-                    case 2: terrainType = TerrainType::STEEL; break;
-                    case 3: terrainType = TerrainType::WATER; break;
-                    case 4: terrainType = TerrainType::BASE_BRICK; break;
-                    default: terrainType = TerrainType::GRASS; break;
-                }
-
-                currentLevelData_.terrain[y][x] = terrainType;
-            }
-        }
-    } else {
-        // Fallback: fill with grass if no data
-        for (auto& row : currentLevelData_.terrain) {
-            row.fill(TerrainType::GRASS);
-        }
-    }
+void LevelManager::generateFallbackTerrain(LevelData& data) const {
+    // No stage files: an empty arena walled in steel with the base fortified
+    data.terrain.resize(13, 13, TerrainType::GRASS);
 
-    // Ensure boundaries are steel
     for (int i = 0; i < 13; ++i) {
-        currentLevelData_.terrain[0][i] = TerrainType::STEEL;
-        currentLevelData_.terrain[12][i] = TerrainType::STEEL;
-        currentLevelData_.terrain[i][0] = TerrainType::STEEL;
-        currentLevelData_.terrain[i][12] = TerrainType::STEEL;
+        data.terrain[0][i] = TerrainType::STEEL;
+        data.terrain[12][i] = TerrainType::STEEL;
+        data.terrain[i][0] = TerrainType::STEEL;
+        data.terrain[i][12] = TerrainType::STEEL;
     }
 
-    // Add base area
     int baseX = 6, baseY = 11;
-    currentLevelData_.terrain[baseY][baseX] = TerrainType::STEEL; // Base itself
-    // Add base brick walls around it
     for (int x = baseX - 1; x <= baseX + 1; ++x) {
-        currentLevelData_.terrain[baseY][x] = TerrainType::BASE_BRICK;
+        data.terrain[baseY][x] = TerrainType::BASE_BRICK;
     }
 }
 
-void LevelManager::setupSpawnPoints() {
-    // Enemy spawn points (top and sides)
-    currentLevelData_.enemySpawnPoints = {
+void LevelManager::setupSpawnPoints(LevelData& data) {
+    // Enemy spawn points (top and sides of the first screen), for stages
+    // whose file doesn't declare its own
+    data.enemySpawnPoints = {
         Vector2::fromPixels(20, 20),   // Top-left
         Vector2::fromPixels(236, 20),  // Top-right
         Vector2::fromPixels(20, 204),  // Bottom-left
@@ -304,13 +382,13 @@ void LevelManager::setupSpawnPoints() {
     };
 
     // Player spawn points
-    currentLevelData_.playerSpawnPoints = {
+    data.playerSpawnPoints = {
         Vector2::fromPixels(80, 200),  // Player 1 (left of base)
         Vector2::fromPixels(160, 200)  // Player 2 (right of base)
     };
 }
 
-void LevelManager::adjustBasePositionForLevel(int level) {
+void LevelManager::adjustBasePositionForLevel(int level, LevelData& data) const {
     // Adjust base position based on level (from original game data)
     int baseX = 120, baseY = 200; // Default position
 
@@ -332,7 +410,7 @@ void LevelManager::adjustBasePositionForLevel(int level) {
             break;
     }
 
-    currentLevelData_.basePosition = Vector2::fromPixels(baseX, baseY);
+    data.basePosition = Vector2::fromPixels(baseX, baseY);
 }
 
 bool LevelManager::shouldSpawnPowerUp() const {
@@ -346,123 +424,66 @@ Vector2 LevelManager::getPowerUpSpawnPosition(const Vector2& enemyPosition) cons
 }
 
 bool LevelManager::isValidTerrainPosition(int x, int y) const {
-    return x >= 0 && x < 13 && y >= 0 && y < 13;
-}
-
-EnemyType LevelManager::getNextEnemyType() {
-    // Enemy spawn pattern based on level progression
-    int totalSpawned = 20 - enemiesToSpawn_;
-    int patternIndex = totalSpawned % 4;
-
-    if (currentLevel_ <= 9) {
-        // Levels 1-9: Basic/Fast pattern
-        return (patternIndex < 3) ? EnemyType::BASIC : EnemyType::FAST;
-    } else if (currentLevel_ <= 19) {
-        // Levels 10-19: Add Heavy
-        switch (patternIndex) {
-            case 0: case 1: return EnemyType::BASIC;
-            case 2: return EnemyType::FAST;
-            case 3: return EnemyType::HEAVY;
-        }
-    } else {
-        // Levels 20-35: Add Elite
-        switch (patternIndex) {
-            case 0: return EnemyType::BASIC;
-            case 1: return EnemyType::FAST;
-            case 2: return EnemyType::HEAVY;
-            case 3: return EnemyType::ELITE;
-        }
-    }
-
-    return EnemyType::BASIC;
-}
-
-int LevelManager::getSpawnInterval() const {
-    // Spawn interval: 1.5-2 seconds (90-120 frames) at 60fps
-    // Base interval is 120 frames (2 seconds), with slight variation
-    int baseInterval = 120;
-    int levelReduction = (currentLevel_ - 1) * 2;
-    int interval = std::max(90, baseInterval - levelReduction); // Minimum 1.5 seconds
-    
-    // Add slight random variation (90-120 frames range)
-    int variation = random_.range(-15, 15);
-    return std::max(90, interval + variation);
+    return currentLevelData_.terrain.contains(x, y);
 }
 
 void LevelManager::render(Renderer& renderer) const {
-    // Render terrain (13x13 grid, each tile is 16x16 pixels)
-    const int TILE_SIZE = 16;
-    
-    for (int y = 0; y < 13; ++y) {
-        for (int x = 0; x < 13; ++x) {
-            TerrainType terrain = currentLevelData_.terrain[y][x];
-            int pixelX = x * TILE_SIZE;
-            int pixelY = y * TILE_SIZE;
-            
-            uint8_t colorIndex;
-            switch (terrain) {
-                case TerrainType::GRASS:
-                    colorIndex = BattleCityPalette::COLOR_GREEN;
-                    break;
-                case TerrainType::BRICK:
-                    colorIndex = BattleCityPalette::COLOR_YELLOW;
-                    break;
-                case TerrainType::STEEL:
-                    colorIndex = BattleCityPalette::COLOR_GRAY;
-                    break;
-                case TerrainType::WATER:
-                    colorIndex = BattleCityPalette::COLOR_CYAN;
-                    break;
-                case TerrainType::BASE_BRICK:
-                    colorIndex = BattleCityPalette::COLOR_YELLOW;
-                    break;
-                default:
-                    colorIndex = BattleCityPalette::COLOR_GREEN;
-                    break;
-            }
-            
-            // Render tile
-            renderer.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, colorIndex);
-            
-            // Add visual details for different terrain types
-            if (terrain == TerrainType::BRICK || terrain == TerrainType::BASE_BRICK) {
-                // Draw brick pattern (simple grid lines)
-                renderer.drawRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, BattleCityPalette::COLOR_BLACK);
-                renderer.drawRect(pixelX + 7, pixelY, 1, TILE_SIZE, BattleCityPalette::COLOR_BLACK);
-                renderer.drawRect(pixelX, pixelY + 7, TILE_SIZE, 1, BattleCityPalette::COLOR_BLACK);
-            } else if (terrain == TerrainType::WATER) {
-                // Draw water animation pattern (simple alternating pattern)
-                for (int wy = 0; wy < TILE_SIZE; wy += 4) {
-                    for (int wx = ((wy / 4) % 2) * 4; wx < TILE_SIZE; wx += 8) {
-                        renderer.fillRect(pixelX + wx, pixelY + wy, 4, 2, BattleCityPalette::COLOR_CYAN);
-                    }
-                }
-            }
+    // Re-rasterize only tiles changed since the last frame, then queue the
+    // cached terrain layers of the chunks on screen (each tile is 16x16
+    // pixels). The canopy goes above the tanks so forest hides them like in
+    // the original game.
+    if (!terrainJournal_.readSince(terrainCacheSequence_, [this](const TerrainChange& change) {
+            terrainCache_.invalidateTile(change.x, change.y);
+        })) {
+        terrainCache_.invalidateAll();
+    }
+    terrainCacheSequence_ = terrainJournal_.getHead();
+
+    Rect view = renderer.getView();
+    terrainCache_.update(currentLevelData_, renderer.getAtlas(), view);
+    renderer.setWaterPhase(animationFrame_ / WATER_CYCLE_FRAMES);
+    if (renderer.isScanlineMode()) {
+        // The nametables are only rebuilt when the cached layers changed (or
+        // the view scrolled on a large arena)
+        ScanlineRenderer& scanline = renderer.getScanline();
+        if (terrainCache_.getChunkCount() == 1 && view.x == 0 && view.y == 0) {
+            scanline.setBackground(terrainCache_.getVersion(), terrainCache_.getGround(), &terrainCache_.getWater(),
+                                   &terrainCache_.getCanopy(), 0, 0);
+        } else {
+            uint32_t version = terrainCache_.composeView(view);
+            scanline.setBackground(version, terrainCache_.getViewGround(), &terrainCache_.getViewWater(),
+                                   &terrainCache_.getViewCanopy(), 0, 0);
         }
+        scanline.setBackgroundVisible(true);
+    } else {
+        terrainCache_.forEachChunk(view, [&renderer](const TerrainCache::Chunk& chunk) {
+            Rect bounds = chunk.getPixelBounds();
+            renderer.queueSurface(RenderLayer::GROUND, chunk.ground, bounds.x, bounds.y);
+            renderer.queueSpans(RenderLayer::WATER, chunk.waterSpans, bounds.x, bounds.y);
+            renderer.queueSpans(RenderLayer::CANOPY, chunk.canopySpans, bounds.x, bounds.y);
+        });
     }
-    
-    // Render base (eagle icon would be rendered here, for now just a colored square)
+
+    // Render base (eagle sprite, colored square if sprites are not loaded)
     int baseX = currentLevelData_.basePosition.pixelX();
     int baseY = currentLevelData_.basePosition.pixelY();
-    renderer.fillRect(baseX - 8, baseY - 8, 16, 16, BattleCityPalette::COLOR_ORANGE);
-    renderer.drawRect(baseX - 8, baseY - 8, 16, 16, BattleCityPalette::COLOR_BLACK);
+    SpriteId baseSprite = renderer.getAtlas().getBase(false);
+    if (baseSprite != INVALID_SPRITE) {
+        renderer.queueSpriteCentered(RenderLayer::GROUND, baseSprite, baseX, baseY);
+        return;
+    }
+    renderer.queueRect(RenderLayer::GROUND, baseX - 8, baseY - 8, 16, 16, BattleCityPalette::COLOR_ORANGE);
+    renderer.queueOutline(RenderLayer::GROUND, baseX - 8, baseY - 8, 16, 16, BattleCityPalette::COLOR_BLACK);
 }
 
 void LevelManager::spawnNextEnemy() {
-    // Check if callback is set
+    const SpawnEntry& entry = currentLevelData_.spawnSchedule[spawnIndex_++];
+
+    // Without a callback the enemy is skipped, not postponed
     if (!enemySpawnCallback_) {
-        return; // No callback set, cannot spawn
+        return;
     }
-
-    // Cycle through spawn points (4 fixed positions)
-    Vector2 spawnPos = currentLevelData_.enemySpawnPoints[spawnIndex_ % 4];
-    spawnIndex_++;
-
-    // Get enemy type for this spawn
-    EnemyType type = getNextEnemyType();
-
-    // Call the spawn callback to actually create the enemy
-    enemySpawnCallback_(type, spawnPos);
+    enemySpawnCallback_(entry.type, currentLevelData_.enemySpawnPoints[entry.spawnPoint]);
 }
 
 } // namespace BattleCity
\ No newline at end of file
@@ -2,23 +2,41 @@
 
 #include "../utils/MathUtils.h"
 #include "../core/Random.h"
+#include "SpawnSchedule.h"
+#include "TerrainCache.h"
+#include "TerrainGrid.h"
+#include "TerrainJournal.h"
 #include <vector>
 #include <array>
 #include <functional>
+#include <future>
+#include <memory>
+#include <string>
 
 namespace BattleCity {
 
-// Level data structure
+// Brick and base brick tiles are 4x4 cells of 4x4 pixels. Bit
+// (cellY * BRICK_CELLS + cellX) of a tile's mask is set while that cell stands.
+constexpr int BRICK_CELL_SIZE = 4;
+constexpr int BRICK_CELLS = 4;
+constexpr uint16_t FULL_BRICK_MASK = 0xFFFF;
+
+// Level data structure. Stages are 13x13 tiles; custom arenas may be larger.
 struct LevelData {
-    int levelNumber;
-    std::array<std::array<TerrainType, 13>, 13> terrain;
+    int levelNumber = 1;
+    TerrainGrid terrain{13, 13};
+    BrickMaskGrid brickMasks{13, 13};  // Same size as terrain, 0 for tiles that are not brick
     Vector2 basePosition;
     std::vector<Vector2> enemySpawnPoints;
     std::vector<Vector2> playerSpawnPoints;
+    std::vector<EnemyType> enemyPattern;  // Spawn order from the stage file (empty: built-in progression)
+    SpawnSchedule spawnSchedule;          // Built from the above when the stage loads
 };
 
 // Forward declaration
 class Game;
+class LevelPack;
+class SpriteAtlas;
 
 // Enemy spawn callback type
 using EnemySpawnCallback = std::function<void(EnemyType, const Vector2&)>;
@@ -31,34 +49,81 @@ private:
     Random& random_;
 
     int enemiesRemaining_;
-    int enemiesToSpawn_;
-    int spawnTimer_;
-    int spawnIndex_;
+    int spawnIndex_;      // Next entry of the spawn schedule
+    int spawnFrame_;      // Playing frames since the stage started
+    int animationFrame_;  // Drives the water shimmer
 
     // Enemy spawn callback
     EnemySpawnCallback enemySpawnCallback_;
 
-    // Enemy spawn patterns per level
-    static const int MAX_LEVELS = 35;
+    // Stages come from the level pack when one is open, from the stage files
+    // (levelNN.txt) otherwise; stages past the last one repeat them in order
+    std::unique_ptr<LevelPack> levelPack_;
+    std::string levelDirectory_;
+    int levelFileCount_;
+
+    // A stage loaded and rasterized ahead of time on a worker thread
+    struct PreparedStage {
+        int level = 0;
+        LevelData data;
+        TerrainCache terrain;
+    };
+    std::future<std::unique_ptr<PreparedStage>> preload_;
+    int preloadLevel_;  // Stage the worker is preparing
+
+    // Every terrain change since the stage was loaded, for incremental readers
+    TerrainJournal terrainJournal_;
+
+    // Pre-rendered terrain, refreshed lazily in render() from the journal
+    mutable TerrainCache terrainCache_;
+    mutable uint32_t terrainCacheSequence_;
+
+    static const int WATER_CYCLE_FRAMES = 32;  // Frames per water shimmer phase
 
 public:
+    static constexpr int MAX_LEVELS = 35;  // Stages in the campaign
+
     LevelManager(Random& random);
+    ~LevelManager();
 
     // Level management
     void loadLevel(int level);
+
+    // Build a stage's data and terrain layers on a worker thread; loading
+    // that stage later only swaps them in. The atlas must stay loaded.
+    void preloadLevel(int level, const SpriteAtlas& atlas);
+    void cancelPreload();
+    bool isPreloading() const { return preload_.valid(); }
     void update(bool isPlaying = true); // Only update spawning when playing
     void reset();
 
+    // Load stages from another directory or pack file (custom stages)
+    void setLevelDirectory(const std::string& directory);
+    bool setLevelPack(const std::string& path);
+
     // Getters
     int getCurrentLevel() const { return currentLevel_; }
     const LevelData& getCurrentLevelData() const { return currentLevelData_; }
+    const TerrainJournal& getTerrainJournal() const { return terrainJournal_; }
     TerrainType getTerrain(int x, int y) const;
     bool isBlocked(int x, int y, bool isBullet = false) const;
+
+    // Pixel area tanks and bullets may move in: the terrain, but never less
+    // than the 256x224 screen the default spawn points are laid out for
+    Rect getWorldBounds() const;
+
+    // Pixel queries. Brick only counts where its cells still stand, so a
+    // chipped tile is open in the destroyed part.
+    TerrainType getTerrainAtPixel(int pixelX, int pixelY) const;
+    bool isAreaBlocked(const Rect& area, bool isBullet = false) const;
+    const SpawnSchedule& getSpawnSchedule() const { return currentLevelData_.spawnSchedule; }
     bool isLevelComplete() const { return enemiesRemaining_ == 0; }
     int getEnemiesRemaining() const { return enemiesRemaining_; }
 
-    // Terrain modification
-    void destroyBrick(int x, int y);
+    // Terrain modification. A bullet hit knocks out a strip of cells 8 pixels
+    // wide across its path, one cell deep (two with power 2 or more). Every
+    // changed tile is recorded in the terrain journal.
+    bool damageBricks(int pixelX, int pixelY, Direction direction, int power);
     void rebuildBaseBricks();
 
     // Enemy management
@@ -72,6 +137,9 @@ public:
     const std::vector<Vector2>& getEnemySpawnPoints() const { return currentLevelData_.enemySpawnPoints; }
     const std::vector<Vector2>& getPlayerSpawnPoints() const { return currentLevelData_.playerSpawnPoints; }
 
+    // Default enemy and player spawn points (stage files may move the players)
+    static void setupSpawnPoints(LevelData& data);
+
     // Enemy spawn callback setup
     void setEnemySpawnCallback(EnemySpawnCallback callback) { enemySpawnCallback_ = callback; }
 
@@ -81,17 +149,20 @@ public:
 private:
     // Level data loading
     void generateLevelData(int level);
-    void loadTerrainData(int level);
-    void setupSpawnPoints();
+    void buildLevelData(int level, LevelData& data) const;  // Safe on the preload thread
+    bool loadLevelFile(int level, LevelData& data) const;
+    void generateFallbackTerrain(LevelData& data) const;
+    int countStages() const;
+    std::unique_ptr<PreparedStage> takePreloaded(int level);
 
     // Enemy spawning
-    EnemyType getNextEnemyType();
-    int getSpawnInterval() const;
     void spawnNextEnemy();
 
     // Terrain helpers
     bool isValidTerrainPosition(int x, int y) const;
-    void adjustBasePositionForLevel(int level);
+    uint16_t clearBrickCells(int tileX, int tileY, uint16_t cells);
+    void setTile(int x, int y, TerrainType terrain, uint16_t brickMask);
+    void adjustBasePositionForLevel(int level, LevelData& data) const;
 };
 
 } // namespace BattleCity
\ No newline at end of file
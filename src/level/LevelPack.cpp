@@ -0,0 +1,189 @@
+#include "LevelPack.h"
+#include "../utils/FileUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace BattleCity {
+
+namespace {
+
+constexpr int RUN_BITS = 5;
+constexpr int MAX_RUN = 1 << RUN_BITS;
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void encodeStage(const LevelData& level, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> runs;
+    const int cells = LEVEL_TILES * LEVEL_TILES;
+    for (int i = 0; i < cells;) {
+        int tile = LevelLoader::terrainToTile(level.terrain[i / LEVEL_TILES][i % LEVEL_TILES]);
+        int run = 1;
+        while (i + run < cells && run < MAX_RUN &&
+               LevelLoader::terrainToTile(level.terrain[(i + run) / LEVEL_TILES][(i + run) % LEVEL_TILES]) == tile) {
+            ++run;
+        }
+        runs.push_back(static_cast<uint8_t>((tile << RUN_BITS) | (run - 1)));
+        i += run;
+    }
+
+    PackedStage stage = {};
+    stage.baseX = static_cast<uint16_t>(level.basePosition.pixelX());
+    stage.baseY = static_cast<uint16_t>(level.basePosition.pixelY());
+    stage.playerCount = static_cast<uint8_t>(std::min<size_t>(level.playerSpawnPoints.size(), LEVEL_MAX_PLAYERS));
+    for (int i = 0; i < stage.playerCount; ++i) {
+        stage.players[i][0] = static_cast<uint16_t>(level.playerSpawnPoints[i].pixelX());
+        stage.players[i][1] = static_cast<uint16_t>(level.playerSpawnPoints[i].pixelY());
+    }
+    stage.enemySpawnCount = static_cast<uint8_t>(std::min<size_t>(level.enemySpawnPoints.size(), LEVEL_MAX_ENEMY_SPAWNS));
+    for (int i = 0; i < stage.enemySpawnCount; ++i) {
+        stage.enemySpawns[i][0] = static_cast<uint16_t>(level.enemySpawnPoints[i].pixelX());
+        stage.enemySpawns[i][1] = static_cast<uint16_t>(level.enemySpawnPoints[i].pixelY());
+    }
+    for (int i = 0; i < LEVEL_ENEMY_COUNT && i < static_cast<int>(level.enemyPattern.size()); ++i) {
+        stage.enemies[i / 4] |= static_cast<uint8_t>(static_cast<int>(level.enemyPattern[i]) << ((i % 4) * 2));
+    }
+    stage.terrainSize = static_cast<uint16_t>(runs.size());
+
+    size_t start = out.size();
+    out.resize(start + sizeof(stage));
+    std::memcpy(out.data() + start, &stage, sizeof(stage));
+    out.insert(out.end(), runs.begin(), runs.end());
+}
+
+} // namespace
+
+bool LevelPack::open(const std::string& path) {
+    data_ = FileUtils::readBinaryFile(path);
+    if (data_.empty()) return false;
+
+    if (!validate()) {
+        std::cerr << "LevelPack: " << path << " is not a valid version " << LEVEL_PACK_VERSION
+                  << " level pack" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+int LevelPack::getStageCount() const {
+    return isOpen() ? static_cast<int>(reinterpret_cast<const LevelPackHeader*>(data_.data())->stageCount) : 0;
+}
+
+bool LevelPack::hasStage(int stage) const {
+    return stage >= 1 && stage <= getStageCount() && getEntry(stage - 1).size != 0;
+}
+
+bool LevelPack::isOlderThan(const std::string& path, const std::string& directory) const {
+    std::error_code error;
+    auto packTime = std::filesystem::last_write_time(path, error);
+    if (error) return false;
+
+    // A pack shipped without the text files is never out of date
+    for (int stage = 1; stage <= LevelManager::MAX_LEVELS; ++stage) {
+        auto textTime = std::filesystem::last_write_time(LevelLoader::levelPath(directory, stage), error);
+        if (error) return false;
+        if (textTime > packTime || stage > getStageCount()) return true;
+    }
+    return false;
+}
+
+const LevelPackEntry& LevelPack::getEntry(int index) const {
+    return reinterpret_cast<const LevelPackEntry*>(data_.data() + sizeof(LevelPackHeader))[index];
+}
+
+bool LevelPack::loadStage(int stage, LevelData& level) const {
+    if (!hasStage(stage)) return false;
+
+    // Only this stage's bytes are checked and decoded
+    const LevelPackEntry& entry = getEntry(stage - 1);
+    const uint8_t* payload = data_.data() + entry.offset;
+    if (checksum(payload, entry.size) != entry.checksum) {
+        std::cerr << "LevelPack: stage " << stage << " is corrupt" << std::endl;
+        return false;
+    }
+
+    PackedStage packed;
+    std::memcpy(&packed, payload, sizeof(packed));
+    if (packed.playerCount == 0 || packed.playerCount > LEVEL_MAX_PLAYERS ||
+        packed.enemySpawnCount > LEVEL_MAX_ENEMY_SPAWNS || sizeof(packed) + packed.terrainSize != entry.size) {
+        return false;
+    }
+
+    const uint8_t* runs = payload + sizeof(packed);
+    level.terrain.resize(LEVEL_TILES, LEVEL_TILES);
+    int cell = 0;
+    for (int i = 0; i < packed.terrainSize; ++i) {
+        int tile = runs[i] >> RUN_BITS;
+        int run = (runs[i] & (MAX_RUN - 1)) + 1;
+        if (tile > LEVEL_MAX_TILE || cell + run > LEVEL_TILES * LEVEL_TILES) return false;
+        TerrainType terrain = LevelLoader::tileToTerrain(tile);
+        for (; run > 0; --run, ++cell) {
+            level.terrain[cell / LEVEL_TILES][cell % LEVEL_TILES] = terrain;
+        }
+    }
+    if (cell != LEVEL_TILES * LEVEL_TILES) return false;
+
+    level.enemyPattern.resize(LEVEL_ENEMY_COUNT);
+    for (int i = 0; i < LEVEL_ENEMY_COUNT; ++i) {
+        level.enemyPattern[i] = static_cast<EnemyType>((packed.enemies[i / 4] >> ((i % 4) * 2)) & 0x03);
+    }
+    level.basePosition = Vector2::fromPixels(packed.baseX, packed.baseY);
+    level.playerSpawnPoints.clear();
+    for (int i = 0; i < packed.playerCount; ++i) {
+        level.playerSpawnPoints.push_back(Vector2::fromPixels(packed.players[i][0], packed.players[i][1]));
+    }
+    level.enemySpawnPoints.clear();
+    for (int i = 0; i < packed.enemySpawnCount; ++i) {
+        level.enemySpawnPoints.push_back(Vector2::fromPixels(packed.enemySpawns[i][0], packed.enemySpawns[i][1]));
+    }
+    return true;
+}
+
+std::vector<uint8_t> LevelPack::build(const std::vector<LevelData>& stages) {
+    size_t indexEnd = sizeof(LevelPackHeader) + stages.size() * sizeof(LevelPackEntry);
+    std::vector<uint8_t> pack(indexEnd, 0);
+
+    std::vector<LevelPackEntry> index(stages.size());
+    for (size_t i = 0; i < stages.size(); ++i) {
+        if (!LevelLoader::isStandardSize(stages[i])) continue;  // Empty entry
+        size_t offset = pack.size();
+        encodeStage(stages[i], pack);
+        index[i] = {static_cast<uint32_t>(offset), static_cast<uint32_t>(pack.size() - offset),
+                    checksum(pack.data() + offset, pack.size() - offset), 0};
+    }
+
+    LevelPackHeader header = {LEVEL_PACK_MAGIC, LEVEL_PACK_VERSION, static_cast<uint32_t>(stages.size()), 0};
+    std::memcpy(pack.data(), &header, sizeof(header));
+    if (!index.empty()) {
+        std::memcpy(pack.data() + sizeof(header), index.data(), index.size() * sizeof(LevelPackEntry));
+    }
+    return pack;
+}
+
+bool LevelPack::validate() const {
+    if (data_.size() < sizeof(LevelPackHeader)) return false;
+
+    const LevelPackHeader* header = reinterpret_cast<const LevelPackHeader*>(data_.data());
+    if (header->magic != LEVEL_PACK_MAGIC || header->version != LEVEL_PACK_VERSION) return false;
+    if (sizeof(LevelPackHeader) + static_cast<size_t>(header->stageCount) * sizeof(LevelPackEntry) > data_.size()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->stageCount; ++i) {
+        const LevelPackEntry& entry = getEntry(static_cast<int>(i));
+        if (entry.size == 0) continue;  // Stage kept in its file
+        if (entry.size < sizeof(PackedStage)) return false;
+        if (static_cast<size_t>(entry.offset) + entry.size > data_.size()) return false;
+    }
+    return true;
+}
+
+} // namespace BattleCity
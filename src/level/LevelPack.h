@@ -0,0 +1,80 @@
+#pragma once
+
+#include "LevelLoader.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BattleCity {
+
+// All stages in one file (written by tools/asset_baker from assets/levels).
+//
+// Layout: LevelPackHeader, stageCount LevelPackEntry records in stage order,
+// then the stage payloads. A payload is a PackedStage followed by the
+// terrain as run-length bytes (tile value in the top 3 bits, run length - 1
+// in the low 5) over the 13x13 grid in row order. Little-endian throughout.
+// Stages of another size keep an empty entry and are read from their file.
+constexpr uint32_t LEVEL_PACK_MAGIC = 0x504C4342;  // "BCLP"
+constexpr uint32_t LEVEL_PACK_VERSION = 2;
+constexpr const char* LEVEL_PACK_FILE_NAME = "levels.pack";
+
+struct LevelPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stageCount;
+    uint32_t reserved;
+};
+
+struct LevelPackEntry {
+    uint32_t offset;    // From the start of the file
+    uint32_t size;      // Payload size in bytes
+    uint32_t checksum;  // FNV-1a of the payload
+    uint32_t reserved;
+};
+
+struct PackedStage {
+    uint16_t baseX, baseY;     // Pixels
+    uint16_t players[LEVEL_MAX_PLAYERS][2];
+    uint16_t enemySpawns[LEVEL_MAX_ENEMY_SPAWNS][2];
+    uint8_t enemies[LEVEL_ENEMY_COUNT / 4];  // EnemyType, four per byte (low bits first)
+    uint8_t playerCount;
+    uint8_t enemySpawnCount;   // 0: the default spawn points
+    uint8_t reserved;
+    uint16_t terrainSize;      // Run bytes that follow
+};
+
+static_assert(sizeof(LevelPackHeader) == 16, "LevelPackHeader layout");
+static_assert(sizeof(LevelPackEntry) == 16, "LevelPackEntry layout");
+static_assert(sizeof(PackedStage) == 54, "PackedStage layout");
+
+// Reads the header and index once; stages are checked and decoded one at a
+// time when they are loaded.
+class LevelPack {
+private:
+    std::vector<uint8_t> data_;
+
+public:
+    bool open(const std::string& path);
+    void close() { data_.clear(); }
+    bool isOpen() const { return !data_.empty(); }
+
+    int getStageCount() const;
+    bool hasStage(int stage) const;  // False for stages kept in their file
+
+    // True when the stage files in directory changed after the pack at path
+    // was baked: a text file is newer than the pack, or there are more of them
+    bool isOlderThan(const std::string& path, const std::string& directory) const;
+
+    // Decode stage (1-based) into level; false if missing or corrupt
+    bool loadStage(int stage, LevelData& level) const;
+
+    // Pack the stages in order (used by the asset baker); stages that are
+    // not 13x13 get an empty entry
+    static std::vector<uint8_t> build(const std::vector<LevelData>& stages);
+
+private:
+    bool validate() const;
+    const LevelPackEntry& getEntry(int index) const;
+};
+
+} // namespace BattleCity
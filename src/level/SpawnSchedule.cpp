@@ -0,0 +1,50 @@
+#include "SpawnSchedule.h"
+#include "../core/Random.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace BattleCity {
+
+namespace {
+
+const char* enemyName(EnemyType type) {
+    switch (type) {
+        case EnemyType::BASIC: return "BASIC";
+        case EnemyType::FAST: return "FAST";
+        case EnemyType::HEAVY: return "HEAVY";
+        case EnemyType::ELITE: return "ELITE";
+    }
+    return "?";
+}
+
+} // namespace
+
+SpawnSchedule buildSpawnSchedule(int level, const std::vector<EnemyType>& pattern, int spawnPointCount) {
+    const EnemyType* order = DEFAULT_ENEMY_ORDER[level <= 9 ? 0 : level <= 19 ? 1 : 2];
+    int interval = std::max(90, 120 - (level - 1) * 2);
+    Random random(static_cast<uint32_t>(level));
+
+    SpawnSchedule schedule = {};
+    int frame = FIRST_SPAWN_FRAME;
+    for (int i = 0; i < LEVEL_ENEMY_COUNT; ++i) {
+        SpawnEntry& entry = schedule[i];
+        entry.type = i < static_cast<int>(pattern.size()) ? pattern[i] : order[i % 4];
+        entry.spawnPoint = static_cast<uint8_t>(i % std::max(spawnPointCount, 1));
+        entry.frame = static_cast<uint16_t>(frame);
+        frame += std::max(90, interval + random.range(-15, 15));
+    }
+    return schedule;
+}
+
+std::string describeSpawnSchedule(const SpawnSchedule& schedule) {
+    std::string text;
+    char line[64];
+    for (int i = 0; i < LEVEL_ENEMY_COUNT; ++i) {
+        std::snprintf(line, sizeof(line), "%3d  frame %5d  point %d  %s\n", i + 1, schedule[i].frame,
+                      schedule[i].spawnPoint, enemyName(schedule[i].type));
+        text += line;
+    }
+    return text;
+}
+
+} // namespace BattleCity
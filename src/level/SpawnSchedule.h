@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../utils/MathUtils.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BattleCity {
+
+constexpr int LEVEL_ENEMY_COUNT = 20;  // Enemies per stage
+
+// One enemy of a stage: what appears, where and when
+struct SpawnEntry {
+    EnemyType type;
+    uint8_t spawnPoint;  // Index into the stage's enemy spawn points
+    uint16_t frame;      // Playing frames after the stage starts
+};
+
+using SpawnSchedule = std::array<SpawnEntry, LEVEL_ENEMY_COUNT>;
+
+// Enemy order for stages whose file has no spawn list, by stage range and
+// repeated every four enemies
+constexpr EnemyType DEFAULT_ENEMY_ORDER[3][4] = {
+    {EnemyType::BASIC, EnemyType::BASIC, EnemyType::BASIC, EnemyType::FAST},   // Stages 1-9
+    {EnemyType::BASIC, EnemyType::BASIC, EnemyType::FAST, EnemyType::HEAVY},   // 10-19
+    {EnemyType::BASIC, EnemyType::FAST, EnemyType::HEAVY, EnemyType::ELITE}};  // 20 and up
+
+constexpr int FIRST_SPAWN_FRAME = 48;  // 800ms at 60fps
+constexpr int DEFAULT_ENEMY_SPAWN_POINTS = 4;  // See LevelManager::setupSpawnPoints
+
+// The whole spawn sequence of a stage, built once when it loads. Enemies
+// follow the stage's spawn list (empty: the default order) and cycle over
+// the spawn points. Gaps are 90-120 frames, shorter on later stages, with a
+// variation seeded by the stage number so a stage always plays the same.
+SpawnSchedule buildSpawnSchedule(int level, const std::vector<EnemyType>& pattern, int spawnPointCount);
+
+// One line per enemy ("  7  frame  745  point 2  FAST"), for tools
+std::string describeSpawnSchedule(const SpawnSchedule& schedule);
+
+} // namespace BattleCity
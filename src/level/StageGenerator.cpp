@@ -0,0 +1,153 @@
+#include "StageGenerator.h"
+#include <algorithm>
+#include <bitset>
+
+namespace BattleCity {
+
+namespace {
+
+void tileOf(const Vector2& position, int& x, int& y) {
+    x = std::clamp(position.pixelX() / 16, 0, LEVEL_TILES - 1);
+    y = std::clamp(position.pixelY() / 16, 0, LEVEL_TILES - 1);
+}
+
+bool isSet(const StageGenerator::TileRows& rows, int x, int y) {
+    return (rows[y] >> x) & 1;
+}
+
+} // namespace
+
+StageGenerator::StageGenerator(uint32_t seed) : random_(seed), rejected_(0) {
+}
+
+bool StageGenerator::generate(LevelData& level, const StageGeneratorSettings& settings) {
+    // Same base spot as the built-in stages; enemies use the default progression
+    level.basePosition = Vector2::fromPixels(120, 200);
+    level.enemyPattern.clear();
+    level.terrain.resize(LEVEL_TILES, LEVEL_TILES);
+    level.brickMasks.resize(LEVEL_TILES, LEVEL_TILES);
+    LevelManager::setupSpawnPoints(level);
+    level.spawnSchedule = buildSpawnSchedule(level.levelNumber, level.enemyPattern,
+                                             static_cast<int>(level.enemySpawnPoints.size()));
+
+    int columns = settings.symmetry == StageSymmetry::MIRROR ? (LEVEL_TILES + 1) / 2 : LEVEL_TILES;
+    for (int attempt = 0; attempt < settings.maxAttempts; ++attempt) {
+        for (int y = 0; y < LEVEL_TILES; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                level.terrain[y][x] = randomTerrain(settings);
+                if (settings.symmetry == StageSymmetry::MIRROR) {
+                    level.terrain[y][LEVEL_TILES - 1 - x] = level.terrain[y][x];
+                }
+            }
+        }
+        reserveSpawnAreas(level);
+
+        if (validate(level)) {
+            for (int y = 0; y < LEVEL_TILES; ++y) {
+                for (int x = 0; x < LEVEL_TILES; ++x) {
+                    bool brick = hasTerrainFlag(level.terrain[y][x], TERRAIN_DESTRUCTIBLE);
+                    level.brickMasks[y][x] = brick ? FULL_BRICK_MASK : 0;
+                }
+            }
+            return true;
+        }
+        ++rejected_;
+    }
+    return false;
+}
+
+bool StageGenerator::validate(const LevelData& level) {
+    // Bricks can be shot away, so only steel and water cut the map apart
+    TileRows open = {};
+    int openTiles = 0;
+    for (int y = 0; y < LEVEL_TILES; ++y) {
+        for (int x = 0; x < LEVEL_TILES; ++x) {
+            // Blocking for good: stops tanks and can't be shot away
+            uint8_t flags = getTerrainFlags(level.terrain[y][x]);
+            if ((flags & (TERRAIN_BLOCKS_TANKS | TERRAIN_DESTRUCTIBLE)) != TERRAIN_BLOCKS_TANKS) {
+                open[y] = static_cast<uint16_t>(open[y] | (1u << x));
+            }
+        }
+        openTiles += static_cast<int>(std::bitset<16>(open[y]).count());
+    }
+    if (openTiles < MIN_OPEN_TILES) return false;
+
+    // Connectivity is symmetric: everything must be reachable from the base
+    int x, y;
+    tileOf(level.basePosition, x, y);
+    TileRows reached = floodFill(open, x, y);
+    for (const auto* points : {&level.enemySpawnPoints, &level.playerSpawnPoints}) {
+        for (const Vector2& point : *points) {
+            tileOf(point, x, y);
+            if (!isSet(reached, x, y)) return false;
+        }
+    }
+    return !level.enemySpawnPoints.empty() && !level.playerSpawnPoints.empty();
+}
+
+StageGenerator::TileRows StageGenerator::floodFill(const TileRows& open, int x, int y) {
+    TileRows reached = {};
+    if (!isSet(open, x, y)) return reached;
+    reached[y] = static_cast<uint16_t>(1u << x);
+
+    // Whole rows at a time: each row takes what its neighbours reached, then
+    // spreads sideways. Sweeping down and up alternately converges in a few
+    // passes on open maps.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int i = 0; i < LEVEL_TILES; ++i) {
+                int row = pass == 0 ? i : LEVEL_TILES - 1 - i;
+                unsigned bits = reached[row];
+                if (row > 0) bits |= reached[row - 1];
+                if (row + 1 < LEVEL_TILES) bits |= reached[row + 1];
+                bits &= open[row];
+
+                unsigned previous;
+                do {
+                    previous = bits;
+                    bits |= ((bits << 1) | (bits >> 1)) & open[row];
+                } while (bits != previous);
+
+                if (bits != reached[row]) {
+                    reached[row] = static_cast<uint16_t>(bits);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return reached;
+}
+
+TerrainType StageGenerator::randomTerrain(const StageGeneratorSettings& settings) {
+    int roll = random_.range(0, 99);
+    if ((roll -= settings.brickPercent) < 0) return TerrainType::BRICK;
+    if ((roll -= settings.steelPercent) < 0) return TerrainType::STEEL;
+    if ((roll -= settings.waterPercent) < 0) return TerrainType::WATER;
+    if ((roll -= settings.forestPercent) < 0) return TerrainType::FOREST;
+    return TerrainType::GRASS;
+}
+
+void StageGenerator::reserveSpawnAreas(LevelData& level) const {
+    // Spawn tiles stay clear so nothing appears inside a wall
+    int x, y;
+    for (const auto* points : {&level.enemySpawnPoints, &level.playerSpawnPoints}) {
+        for (const Vector2& point : *points) {
+            tileOf(point, x, y);
+            level.terrain[y][x] = TerrainType::GRASS;
+        }
+    }
+
+    // The base sits on floor inside a ring of base bricks
+    tileOf(level.basePosition, x, y);
+    for (int ringY = y - 1; ringY <= y + 1; ++ringY) {
+        for (int ringX = x - 1; ringX <= x + 1; ++ringX) {
+            if (ringX < 0 || ringX >= LEVEL_TILES || ringY < 0 || ringY >= LEVEL_TILES) continue;
+            level.terrain[ringY][ringX] = TerrainType::BASE_BRICK;
+        }
+    }
+    level.terrain[y][x] = TerrainType::GRASS;
+}
+
+} // namespace BattleCity
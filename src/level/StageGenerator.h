@@ -0,0 +1,61 @@
+#pragma once
+
+#include "LevelLoader.h"
+#include "../core/Random.h"
+#include <array>
+#include <cstdint>
+
+namespace BattleCity {
+
+enum class StageSymmetry {
+    NONE,
+    MIRROR      // Left half mirrored onto the right
+};
+
+// Share of tiles given to each terrain type, in percent (the rest is floor)
+struct StageGeneratorSettings {
+    StageSymmetry symmetry = StageSymmetry::MIRROR;
+    int brickPercent = 30;
+    int steelPercent = 6;
+    int waterPercent = 5;
+    int forestPercent = 8;
+    int maxAttempts = 64;   // Rejected layouts before generate() gives up
+};
+
+// Builds random stages from a seed (bot training, endless mode). The same
+// seed and settings always give the same stages.
+class StageGenerator {
+public:
+    // One bit per tile, bit x of row y
+    using TileRows = std::array<uint16_t, LEVEL_TILES>;
+
+    // Fewer open tiles than this is a maze of walls, not a stage
+    static constexpr int MIN_OPEN_TILES = LEVEL_TILES * LEVEL_TILES / 2;
+
+private:
+    Random random_;
+    uint32_t rejected_;
+
+public:
+    explicit StageGenerator(uint32_t seed);
+
+    // Fill level with a new stage: terrain, base, default spawn points and
+    // the built-in enemy progression for level.levelNumber. False if every attempt was rejected.
+    bool generate(LevelData& level, const StageGeneratorSettings& settings = StageGeneratorSettings());
+
+    // Every enemy spawn, player spawn and the base must be connected through
+    // tiles a tank can drive or shoot through (steel and water block)
+    static bool validate(const LevelData& level);
+
+    // Tiles reachable from (x, y) over the open tiles
+    static TileRows floodFill(const TileRows& open, int x, int y);
+
+    uint32_t getRejectedCount() const { return rejected_; }
+    void setSeed(uint32_t seed) { random_.setSeed(seed); }
+
+private:
+    TerrainType randomTerrain(const StageGeneratorSettings& settings);
+    void reserveSpawnAreas(LevelData& level) const;
+};
+
+} // namespace BattleCity
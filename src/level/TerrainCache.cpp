@@ -0,0 +1,286 @@
+#include "TerrainCache.h"
+#include "LevelManager.h"
+#include "../graphics/Palette.h"
+#include "../graphics/SpriteAtlas.h"
+#include <algorithm>
+
+namespace BattleCity {
+
+TerrainCache::TerrainCache()
+    : width_(0), height_(0), chunksX_(0), usingAtlas_(false), version_(0), viewVersion_(0) {
+    resize(13, 13);
+}
+
+void TerrainCache::resize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    chunksX_ = (width + CHUNK_TILES - 1) / CHUNK_TILES;
+    int chunksY = (height + CHUNK_TILES - 1) / CHUNK_TILES;
+
+    chunks_.clear();
+    chunks_.resize(static_cast<size_t>(chunksX_) * chunksY);
+    for (int y = 0; y < chunksY; ++y) {
+        for (int x = 0; x < chunksX_; ++x) {
+            Chunk& chunk = chunks_[y * chunksX_ + x];
+            chunk.tileX = x * CHUNK_TILES;
+            chunk.tileY = y * CHUNK_TILES;
+            chunk.tilesWide = std::min(CHUNK_TILES, width - chunk.tileX);
+            chunk.tilesHigh = std::min(CHUNK_TILES, height - chunk.tileY);
+            chunk.allocated = false;
+            chunk.dirtyTiles.set();
+        }
+    }
+
+    // A single-chunk map always has its layers (getGround() and friends)
+    if (chunks_.size() == 1) {
+        allocate(chunks_[0]);
+    }
+}
+
+void TerrainCache::invalidateAll() {
+    for (Chunk& chunk : chunks_) {
+        chunk.dirtyTiles.set();
+    }
+}
+
+void TerrainCache::invalidateTile(int x, int y) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+    Chunk& chunk = chunks_[(y / CHUNK_TILES) * chunksX_ + x / CHUNK_TILES];
+    chunk.dirtyTiles.set((y % CHUNK_TILES) * CHUNK_TILES + x % CHUNK_TILES);
+}
+
+bool TerrainCache::isDirty() const {
+    return std::any_of(chunks_.begin(), chunks_.end(), [](const Chunk& chunk) { return chunk.dirtyTiles.any(); });
+}
+
+void TerrainCache::replaceWith(TerrainCache&& other) {
+    uint32_t version = std::max(version_, other.version_) + 1;
+    *this = std::move(other);
+    version_ = version;
+}
+
+void TerrainCache::update(const LevelData& levelData, const SpriteAtlas& atlas) {
+    update(levelData, atlas, Rect(0, 0, levelData.terrain.getWidth() * TILE_SIZE,
+                                  levelData.terrain.getHeight() * TILE_SIZE));
+}
+
+void TerrainCache::update(const LevelData& levelData, const SpriteAtlas& atlas, const Rect& view) {
+    if (levelData.terrain.getWidth() != width_ || levelData.terrain.getHeight() != height_) {
+        resize(levelData.terrain.getWidth(), levelData.terrain.getHeight());
+    }
+
+    // Sprites loaded (or unloaded) since the last update: redraw everything
+    if (atlas.isLoaded() != usingAtlas_) {
+        usingAtlas_ = atlas.isLoaded();
+        invalidateAll();
+    }
+
+    // Chunks more than a chunk away from the view give their memory back
+    Rect nearby(view.x - CHUNK_PIXELS, view.y - CHUNK_PIXELS, view.w + 2 * CHUNK_PIXELS, view.h + 2 * CHUNK_PIXELS);
+    bool changed = false;
+    for (Chunk& chunk : chunks_) {
+        Rect bounds = chunk.getPixelBounds();
+        if (chunks_.size() > 1 && !bounds.intersects(nearby)) {
+            if (chunk.allocated) release(chunk);
+        } else if (bounds.intersects(view)) {
+            changed |= updateChunk(chunk, levelData, atlas);
+        }
+    }
+    if (changed) ++version_;
+}
+
+uint32_t TerrainCache::composeView(const Rect& view) {
+    if (viewVersion_ == version_ && view.x == viewRect_.x && view.y == viewRect_.y &&
+        view.w == viewRect_.w && view.h == viewRect_.h) {
+        return viewVersion_;
+    }
+
+    if (viewGround_.getWidth() != view.w || viewGround_.getHeight() != view.h) {
+        viewGround_.resize(view.w, view.h);
+        viewWater_.resize(view.w, view.h);
+        viewCanopy_.resize(view.w, view.h);
+    }
+    viewGround_.clear(BattleCityPalette::COLOR_BLACK);
+    viewWater_.clear(0);
+    viewCanopy_.clear(0);
+    forEachChunk(view, [&](const Chunk& chunk) {
+        if (!chunk.allocated) return;
+        Rect bounds = chunk.getPixelBounds();
+        viewGround_.blit(chunk.ground, chunk.ground.getBounds(), bounds.x - view.x, bounds.y - view.y);
+        viewWater_.blit(chunk.water, chunk.water.getBounds(), bounds.x - view.x, bounds.y - view.y);
+        viewCanopy_.blit(chunk.canopy, chunk.canopy.getBounds(), bounds.x - view.x, bounds.y - view.y);
+    });
+
+    // A version of its own, so the nametables rebuild whenever the view moves
+    viewRect_ = view;
+    viewVersion_ = ++version_;
+    return viewVersion_;
+}
+
+bool TerrainCache::updateChunk(Chunk& chunk, const LevelData& levelData, const SpriteAtlas& atlas) {
+    if (!chunk.allocated) allocate(chunk);
+    if (chunk.dirtyTiles.none()) return false;
+
+    for (int y = 0; y < chunk.tilesHigh; ++y) {
+        for (int x = 0; x < chunk.tilesWide; ++x) {
+            if (!chunk.dirtyTiles.test(y * CHUNK_TILES + x)) continue;
+
+            // Every tile owns its area in all layers: floor below, nothing above
+            int pixelX = x * TILE_SIZE;
+            int pixelY = y * TILE_SIZE;
+            chunk.ground.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, BattleCityPalette::COLOR_GREEN);
+            chunk.water.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, 0);
+            chunk.canopy.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, 0);
+
+            int tileX = chunk.tileX + x;
+            int tileY = chunk.tileY + y;
+            TerrainType terrain = levelData.terrain[tileY][tileX];
+            if (!usingAtlas_ || !rasterizeTileArt(chunk, x, y, terrain, atlas)) {
+                rasterizeTile(chunk, x, y, terrain);
+            }
+            if (levelData.brickMasks[tileY][tileX] != FULL_BRICK_MASK &&
+                (terrain == TerrainType::BRICK || terrain == TerrainType::BASE_BRICK)) {
+                clearBrickCells(chunk, x, y, levelData.brickMasks[tileY][tileX]);
+            }
+        }
+    }
+
+    // Rebuild the overlay masks once for all changed tiles
+    chunk.waterSpans.encode(chunk.water.getPixels(), chunk.water.getWidth(), chunk.water.getHeight(),
+                            chunk.water.getPitch());
+    chunk.canopySpans.encode(chunk.canopy.getPixels(), chunk.canopy.getWidth(), chunk.canopy.getHeight(),
+                             chunk.canopy.getPitch());
+
+    chunk.dirtyTiles.reset();
+    return true;
+}
+
+void TerrainCache::allocate(Chunk& chunk) {
+    int width = chunk.tilesWide * TILE_SIZE;
+    int height = chunk.tilesHigh * TILE_SIZE;
+    chunk.ground.resize(width, height, BattleCityPalette::COLOR_BLACK);
+    chunk.water.resize(width, height, 0);
+    chunk.canopy.resize(width, height, 0);
+    chunk.dirtyTiles.set();
+    chunk.allocated = true;
+}
+
+void TerrainCache::release(Chunk& chunk) {
+    chunk.ground = IndexedSurface();
+    chunk.water = IndexedSurface();
+    chunk.canopy = IndexedSurface();
+    chunk.waterSpans = SpanSprite();
+    chunk.canopySpans = SpanSprite();
+    chunk.dirtyTiles.set();
+    chunk.allocated = false;
+}
+
+IndexedSurface& TerrainCache::getLayer(Chunk& chunk, TerrainType terrain) {
+    if (hasTerrainFlag(terrain, TERRAIN_COVERS_TANKS)) return chunk.canopy;
+    return terrain == TerrainType::WATER ? chunk.water : chunk.ground;
+}
+
+void TerrainCache::rasterizeTile(Chunk& chunk, int x, int y, TerrainType terrain) {
+    int pixelX = x * TILE_SIZE;
+    int pixelY = y * TILE_SIZE;
+    IndexedSurface& layer = getLayer(chunk, terrain);
+
+    uint8_t colorIndex;
+    switch (terrain) {
+        case TerrainType::GRASS:
+            return;  // Open floor is already filled
+        case TerrainType::BRICK:
+            colorIndex = BattleCityPalette::COLOR_YELLOW;
+            break;
+        case TerrainType::STEEL:
+            colorIndex = BattleCityPalette::COLOR_GRAY;
+            break;
+        case TerrainType::WATER:
+            colorIndex = BattleCityPalette::COLOR_WATER;
+            break;
+        case TerrainType::BASE_BRICK:
+            colorIndex = BattleCityPalette::COLOR_YELLOW;
+            break;
+        case TerrainType::FOREST:
+            // Checkered leaves so tanks underneath still show through
+            for (int fy = 0; fy < TILE_SIZE; fy += 2) {
+                for (int fx = (fy / 2) % 2 * 2; fx < TILE_SIZE; fx += 4) {
+                    layer.fillRect(pixelX + fx, pixelY + fy, 2, 2, BattleCityPalette::COLOR_FOREST);
+                }
+            }
+            return;
+        default:
+            return;
+    }
+
+    layer.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, colorIndex);
+
+    // Add visual details for different terrain types
+    if (terrain == TerrainType::BRICK || terrain == TerrainType::BASE_BRICK) {
+        // Draw brick pattern (simple grid lines)
+        layer.drawRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, BattleCityPalette::COLOR_BLACK);
+        layer.drawRect(pixelX + 7, pixelY, 1, TILE_SIZE, BattleCityPalette::COLOR_BLACK);
+        layer.drawRect(pixelX, pixelY + 7, TILE_SIZE, 1, BattleCityPalette::COLOR_BLACK);
+    } else if (terrain == TerrainType::WATER) {
+        // Draw water pattern (simple alternating pattern)
+        for (int wy = 0; wy < TILE_SIZE; wy += 4) {
+            for (int wx = ((wy / 4) % 2) * 4; wx < TILE_SIZE; wx += 8) {
+                layer.fillRect(pixelX + wx, pixelY + wy, 4, 2, BattleCityPalette::COLOR_WATER_HIGHLIGHT);
+            }
+        }
+    }
+}
+
+bool TerrainCache::rasterizeTileArt(Chunk& chunk, int x, int y, TerrainType terrain, const SpriteAtlas& atlas) {
+    const char* name = nullptr;
+    switch (terrain) {
+        case TerrainType::BRICK:
+        case TerrainType::BASE_BRICK:
+            name = "terrain/terrain_brick";
+            break;
+        case TerrainType::STEEL:
+            name = "terrain/terrain_steel";
+            break;
+        case TerrainType::WATER:
+            name = "terrain/terrain_water";
+            break;
+        case TerrainType::FOREST:
+            name = "terrain/terrain_grass";
+            break;
+        default:
+            return false;  // Open ground keeps its flat color
+    }
+
+    SpriteId sprite = atlas.find(name);
+    if (sprite == INVALID_SPRITE) return false;
+
+    // Terrain art is one 8x8 block, a 16x16 tile is 2x2 blocks
+    const Rect& rect = atlas.getRect(sprite);
+    int pixelX = x * TILE_SIZE;
+    int pixelY = y * TILE_SIZE;
+    IndexedSurface& layer = getLayer(chunk, terrain);
+    if (&layer == &chunk.ground) {
+        chunk.ground.fillRect(pixelX, pixelY, TILE_SIZE, TILE_SIZE, BattleCityPalette::COLOR_BLACK);
+    }
+    for (int by = 0; by < TILE_SIZE; by += rect.h) {
+        for (int bx = 0; bx < TILE_SIZE; bx += rect.w) {
+            layer.blitTransparent(atlas.getSurface(),
+                                  Rect(rect.x, rect.y, std::min(rect.w, TILE_SIZE - bx),
+                                       std::min(rect.h, TILE_SIZE - by)),
+                                  pixelX + bx, pixelY + by);
+        }
+    }
+    return true;
+}
+
+void TerrainCache::clearBrickCells(Chunk& chunk, int x, int y, uint16_t mask) {
+    // Shot-away cells show the floor again
+    for (int cell = 0; cell < BRICK_CELLS * BRICK_CELLS; ++cell) {
+        if (mask & (1u << cell)) continue;
+        chunk.ground.fillRect(x * TILE_SIZE + (cell % BRICK_CELLS) * BRICK_CELL_SIZE,
+                              y * TILE_SIZE + (cell / BRICK_CELLS) * BRICK_CELL_SIZE,
+                              BRICK_CELL_SIZE, BRICK_CELL_SIZE, BattleCityPalette::COLOR_GREEN);
+    }
+}
+
+} // namespace BattleCity
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "TerrainGrid.h"
+#include "../graphics/IndexedSurface.h"
+#include "../graphics/SpanSprite.h"
+#include "../utils/MathUtils.h"
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
+namespace BattleCity {
+
+struct LevelData;
+class SpriteAtlas;
+
+// Pre-rendered terrain layers. Tiles are rasterized once and only
+// re-rasterized after they are invalidated (brick destroyed, base rebuilt,
+// new level loaded), so a frame only needs to composite the cached layers.
+//
+// The terrain is split by draw order: the opaque ground (floor and walls) is
+// below everything, water sits above the floor and forest canopy above the
+// tanks. Water and canopy are kept as span masks so compositing them costs
+// one pass over their covered pixels only.
+//
+// Layers are kept per chunk of the terrain grid. A standard stage is a
+// single chunk; on large arenas only chunks near the view hold layers and
+// the others are dropped until they come back into view.
+class TerrainCache {
+public:
+    static constexpr int TILE_SIZE = 16;
+    static constexpr int CHUNK_TILES = TerrainGrid::CHUNK_TILES;
+    static constexpr int CHUNK_PIXELS = CHUNK_TILES * TILE_SIZE;
+
+    struct Chunk {
+        int tileX, tileY;          // First tile of the chunk
+        int tilesWide, tilesHigh;  // Edge chunks may be smaller
+        IndexedSurface ground;     // Floor, brick, steel (opaque)
+        IndexedSurface water;      // Water tiles (0 elsewhere)
+        IndexedSurface canopy;     // Forest tiles (0 elsewhere)
+        SpanSprite waterSpans;
+        SpanSprite canopySpans;
+        std::bitset<CHUNK_TILES * CHUNK_TILES> dirtyTiles;
+        bool allocated;
+
+        Rect getPixelBounds() const {
+            return Rect(tileX * TILE_SIZE, tileY * TILE_SIZE, tilesWide * TILE_SIZE, tilesHigh * TILE_SIZE);
+        }
+    };
+
+private:
+    std::vector<Chunk> chunks_;
+    int width_;        // Tiles
+    int height_;
+    int chunksX_;
+    bool usingAtlas_;  // Tiles were rasterized from atlas art
+    uint32_t version_; // Bumped whenever tiles are re-rasterized
+
+    // Visible area of all chunks in one set of surfaces (see composeView)
+    IndexedSurface viewGround_;
+    IndexedSurface viewWater_;
+    IndexedSurface viewCanopy_;
+    Rect viewRect_;
+    uint32_t viewVersion_;
+
+public:
+    TerrainCache();
+
+    // Size in tiles; drops every layer
+    void resize(int width, int height);
+
+    // Invalidation
+    void invalidateAll();
+    void invalidateTile(int x, int y);
+    bool isDirty() const;
+
+    // Take over the layers of a cache built elsewhere (a preloaded stage);
+    // the version keeps increasing so dependent caches still see a change
+    void replaceWith(TerrainCache&& other);
+
+    // Re-rasterize dirty tiles from the level data. Uses the 8x8 terrain art
+    // from the atlas when it is loaded, flat colors otherwise. The view
+    // overload (pixels) only touches chunks near the view.
+    void update(const LevelData& levelData, const SpriteAtlas& atlas);
+    void update(const LevelData& levelData, const SpriteAtlas& atlas, const Rect& view);
+
+    // Call fn(chunk) for every chunk overlapping the view (pixels)
+    template <typename Fn>
+    void forEachChunk(const Rect& view, Fn fn) const {
+        int firstX = std::max(view.x, 0) / CHUNK_PIXELS;
+        int firstY = std::max(view.y, 0) / CHUNK_PIXELS;
+        int lastX = std::min((view.x + view.w - 1) / CHUNK_PIXELS, chunksX_ - 1);
+        int lastY = std::min((view.y + view.h - 1) / CHUNK_PIXELS, getChunksY() - 1);
+        for (int y = firstY; y <= lastY; ++y) {
+            for (int x = firstX; x <= lastX; ++x) {
+                fn(chunks_[y * chunksX_ + x]);
+            }
+        }
+    }
+
+    // Copy the view's part of every layer into view-sized surfaces, for
+    // consumers that need one source (the scanline nametables). Returns the
+    // version of the composed view; unchanged views are not copied again.
+    uint32_t composeView(const Rect& view);
+    const IndexedSurface& getViewGround() const { return viewGround_; }
+    const IndexedSurface& getViewWater() const { return viewWater_; }
+    const IndexedSurface& getViewCanopy() const { return viewCanopy_; }
+
+    // Layers of the first chunk, which is the whole map on standard stages
+    const IndexedSurface& getGround() const { return chunks_[0].ground; }
+    const SpanSprite& getWaterSpans() const { return chunks_[0].waterSpans; }
+    const SpanSprite& getCanopySpans() const { return chunks_[0].canopySpans; }
+    const IndexedSurface& getWater() const { return chunks_[0].water; }
+    const IndexedSurface& getCanopy() const { return chunks_[0].canopy; }
+
+    int getChunkCount() const { return static_cast<int>(chunks_.size()); }
+    int getChunksY() const { return chunksX_ > 0 ? static_cast<int>(chunks_.size()) / chunksX_ : 0; }
+    uint32_t getVersion() const { return version_; }
+
+private:
+    void allocate(Chunk& chunk);
+    void release(Chunk& chunk);
+    bool updateChunk(Chunk& chunk, const LevelData& levelData, const SpriteAtlas& atlas);
+    IndexedSurface& getLayer(Chunk& chunk, TerrainType terrain);
+    void rasterizeTile(Chunk& chunk, int x, int y, TerrainType terrain);
+    bool rasterizeTileArt(Chunk& chunk, int x, int y, TerrainType terrain, const SpriteAtlas& atlas);
+    void clearBrickCells(Chunk& chunk, int x, int y, uint16_t mask);
+};
+
+} // namespace BattleCity
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "../utils/MathUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace BattleCity {
+
+// Tile grid of any size up to MAX_TILES x MAX_TILES, stored as square
+// chunks of CHUNK_TILES x CHUNK_TILES tiles. Each chunk is contiguous, so
+// work can be limited to the chunks near the camera. grid[y][x] indexes it
+// like the fixed 2D arrays it replaces.
+template <typename T>
+class ChunkedGrid {
+public:
+    static constexpr int CHUNK_SHIFT = 4;
+    static constexpr int CHUNK_TILES = 1 << CHUNK_SHIFT;
+    static constexpr int CHUNK_CELLS = CHUNK_TILES * CHUNK_TILES;
+    static constexpr int MAX_TILES = 512;
+
+    class Row {
+    private:
+        ChunkedGrid* grid_;
+        int y_;
+
+    public:
+        Row(ChunkedGrid* grid, int y) : grid_(grid), y_(y) {}
+        T& operator[](int x) const { return grid_->at(x, y_); }
+    };
+
+    class ConstRow {
+    private:
+        const ChunkedGrid* grid_;
+        int y_;
+
+    public:
+        ConstRow(const ChunkedGrid* grid, int y) : grid_(grid), y_(y) {}
+        const T& operator[](int x) const { return grid_->at(x, y_); }
+    };
+
+private:
+    int width_;
+    int height_;
+    int chunksX_;
+    int chunksY_;
+    std::vector<T> cells_;  // Chunk by chunk, rows of CHUNK_TILES inside a chunk
+
+public:
+    ChunkedGrid() : width_(0), height_(0), chunksX_(0), chunksY_(0) {}
+    ChunkedGrid(int width, int height, T value = T()) : ChunkedGrid() { resize(width, height, value); }
+
+    // Sizes are clamped to [0, MAX_TILES]; every tile is reset to value
+    void resize(int width, int height, T value = T()) {
+        width_ = std::clamp(width, 0, MAX_TILES);
+        height_ = std::clamp(height, 0, MAX_TILES);
+        chunksX_ = (width_ + CHUNK_TILES - 1) >> CHUNK_SHIFT;
+        chunksY_ = (height_ + CHUNK_TILES - 1) >> CHUNK_SHIFT;
+        cells_.assign(static_cast<size_t>(chunksX_) * chunksY_ * CHUNK_CELLS, value);
+    }
+
+    void fill(T value) { std::fill(cells_.begin(), cells_.end(), value); }
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getChunksX() const { return chunksX_; }
+    int getChunksY() const { return chunksY_; }
+    bool contains(int x, int y) const {
+        // Negative values wrap to large unsigned ones, so one compare per axis
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width_) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height_);
+    }
+
+    // No bounds checks; callers test contains() first
+    T& at(int x, int y) { return cells_[index(x, y)]; }
+    const T& at(int x, int y) const { return cells_[index(x, y)]; }
+    Row operator[](int y) { return Row(this, y); }
+    ConstRow operator[](int y) const { return ConstRow(this, y); }
+
+    bool operator==(const ChunkedGrid& other) const {
+        return width_ == other.width_ && height_ == other.height_ && cells_ == other.cells_;
+    }
+    bool operator!=(const ChunkedGrid& other) const { return !(*this == other); }
+
+private:
+    size_t index(int x, int y) const {
+        size_t chunk = static_cast<size_t>(y >> CHUNK_SHIFT) * chunksX_ + (x >> CHUNK_SHIFT);
+        return (chunk << (2 * CHUNK_SHIFT)) | ((y & (CHUNK_TILES - 1)) << CHUNK_SHIFT) | (x & (CHUNK_TILES - 1));
+    }
+};
+
+using TerrainGrid = ChunkedGrid<TerrainType>;
+using BrickMaskGrid = ChunkedGrid<uint16_t>;
+
+// What each terrain type does, as bits, so terrain queries are one table
+// load and a mask
+enum TerrainFlag : uint8_t {
+    TERRAIN_BLOCKS_TANKS = 1 << 0,
+    TERRAIN_BLOCKS_BULLETS = 1 << 1,  // Must stay BLOCKS_TANKS << 1 (see isBlocked)
+    TERRAIN_DESTRUCTIBLE = 1 << 2,    // Brick cells are shot away
+    TERRAIN_COVERS_TANKS = 1 << 3     // Drawn above the tanks
+};
+
+constexpr uint8_t TERRAIN_FLAGS[TERRAIN_TYPE_COUNT] = {
+    0,                                                                     // GRASS
+    TERRAIN_BLOCKS_TANKS | TERRAIN_BLOCKS_BULLETS | TERRAIN_DESTRUCTIBLE,  // BRICK
+    TERRAIN_BLOCKS_TANKS | TERRAIN_BLOCKS_BULLETS,                         // STEEL
+    TERRAIN_BLOCKS_TANKS,                                                  // WATER
+    TERRAIN_BLOCKS_TANKS | TERRAIN_BLOCKS_BULLETS | TERRAIN_DESTRUCTIBLE,  // BASE_BRICK
+    TERRAIN_COVERS_TANKS                                                   // FOREST
+};
+
+constexpr uint8_t getTerrainFlags(TerrainType terrain) {
+    return TERRAIN_FLAGS[static_cast<uint8_t>(terrain)];
+}
+
+constexpr bool hasTerrainFlag(TerrainType terrain, uint8_t flag) {
+    return (getTerrainFlags(terrain) & flag) != 0;
+}
+
+// Packed terrain: 3 bits per tile, rows top to bottom, low bits first. A
+// 13x13 stage fits in 64 bytes; used for compiled stages and anything else
+// that stores or sends whole maps.
+constexpr int TERRAIN_CELL_BITS = 3;
+
+constexpr size_t getPackedTerrainSize(int width, int height) {
+    return (static_cast<size_t>(width) * height * TERRAIN_CELL_BITS + 7) / 8;
+}
+
+// out must hold getPackedTerrainSize() bytes
+inline void packTerrain(const TerrainGrid& grid, uint8_t* out) {
+    std::fill(out, out + getPackedTerrainSize(grid.getWidth(), grid.getHeight()), uint8_t(0));
+    size_t bit = 0;
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x, bit += TERRAIN_CELL_BITS) {
+            unsigned value = static_cast<uint8_t>(grid[y][x]) << (bit & 7);
+            out[bit >> 3] = static_cast<uint8_t>(out[bit >> 3] | value);
+            if (value > 0xFF) out[(bit >> 3) + 1] = static_cast<uint8_t>(value >> 8);
+        }
+    }
+}
+
+// Fills grid at its current size; false if a cell is not a terrain type
+inline bool unpackTerrain(const uint8_t* in, TerrainGrid& grid) {
+    size_t size = getPackedTerrainSize(grid.getWidth(), grid.getHeight());
+    size_t bit = 0;
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x, bit += TERRAIN_CELL_BITS) {
+            size_t byte = bit >> 3;
+            unsigned window = in[byte] | (byte + 1 < size ? in[byte + 1] << 8 : 0);
+            unsigned value = (window >> (bit & 7)) & ((1u << TERRAIN_CELL_BITS) - 1);
+            if (value >= TERRAIN_TYPE_COUNT) return false;
+            grid[y][x] = static_cast<TerrainType>(value);
+        }
+    }
+    return true;
+}
+
+} // namespace BattleCity
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../utils/MathUtils.h"
+#include <array>
+#include <cstdint>
+
+namespace BattleCity {
+
+// One tile's state after a change
+struct TerrainChange {
+    uint16_t x, y;
+    TerrainType terrain;
+    uint16_t brickMask;
+};
+
+// Log of terrain changes, so systems that derive data from the terrain
+// (render cache, navigation, hashes, network deltas) update only the tiles
+// that changed instead of rescanning the map.
+//
+// Every change gets the next sequence number. A reader keeps the sequence
+// it has read up to and asks for the changes since then; when the map was
+// replaced (new stage) or the reader fell more than CAPACITY changes
+// behind, readSince() fails and the reader rebuilds from the level data.
+class TerrainJournal {
+public:
+    static constexpr uint32_t CAPACITY = 1024;
+
+private:
+    std::array<TerrainChange, CAPACITY> changes_;  // Ring, indexed by sequence
+    uint32_t head_;        // Sequence of the next change
+    uint32_t resetAt_;     // Readers before this must rebuild
+
+public:
+    TerrainJournal() : head_(0), resetAt_(0) {}
+
+    void record(int x, int y, TerrainType terrain, uint16_t brickMask) {
+        changes_[head_ % CAPACITY] = {static_cast<uint16_t>(x), static_cast<uint16_t>(y), terrain, brickMask};
+        ++head_;
+    }
+
+    // The whole map changed; every reader has to rebuild
+    void reset() {
+        ++head_;
+        resetAt_ = head_;
+    }
+
+    uint32_t getHead() const { return head_; }
+
+    // Pass fn(change) every change from sequence since to the head, oldest
+    // first. False if they are no longer all known; the reader must rebuild.
+    template <typename Fn>
+    bool readSince(uint32_t since, Fn fn) const {
+        if (since < resetAt_ || head_ - since > CAPACITY) return false;
+        for (uint32_t sequence = since; sequence != head_; ++sequence) {
+            fn(changes_[sequence % CAPACITY]);
+        }
+        return true;
+    }
+};
+
+} // namespace BattleCity
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <string>
 
 int main(int argc, char* argv[]) {
     try {
@@ -19,6 +20,25 @@ int main(int argc, char* argv[]) {
             return EXIT_FAILURE;
         }
 
+        // Session recording for QA: --record out.mp4 (pipes to ffmpeg)
+        // or --record-png <directory> (one PNG per frame)
+        for (int i = 1; i + 1 < argc; ++i) {
+            std::string option = argv[i];
+            BattleCity::CaptureSettings capture;
+            if (option == "--record") {
+                capture.format = BattleCity::CaptureFormat::RAW_PIPE;
+                capture.target = BattleCity::FrameCapture::ffmpegCommand(argv[++i]);
+            } else if (option == "--record-png") {
+                capture.format = BattleCity::CaptureFormat::PNG_SEQUENCE;
+                capture.target = argv[++i];
+            } else {
+                continue;
+            }
+            if (!game.startCapture(capture)) {
+                std::cerr << "Recording disabled" << std::endl;
+            }
+        }
+
         // Run main game loop
         std::cout << "main: about to call game.run()" << std::endl;
         // Also write to log file for reliable capture
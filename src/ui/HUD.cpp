@@ -2,14 +2,15 @@
 #include "../graphics/Renderer.h"
 #include <sstream>
 #include <iomanip>
-#include <iostream>
 
 namespace BattleCity {
 
 class Game; // Forward declaration to avoid circular dependency
 
+HUD::HUD() : cachedScore_(-1), cachedLevel_(-1) {
+}
+
 void HUD::render(Renderer& renderer, int score, int lives, int level, bool isTwoPlayerMode) {
-    std::cout << "HUD::render score=" << score << " lives=" << lives << " level=" << level << " twoPlayer=" << isTwoPlayerMode << std::endl;
     // Render player 1 lives
     renderPlayerLives(renderer, lives, PLAYER1_LIFE_X, PLAYER1_LIFE_Y);
 
@@ -26,25 +27,27 @@ void HUD::render(Renderer& renderer, int score, int lives, int level, bool isTwo
 }
 
 void HUD::renderPlayerLives(Renderer& renderer, int lives, int x, int y) {
-    std::cout << "HUD::renderPlayerLives rendering " << lives << " lives at (" << x << "," << y << ")" << std::endl;
     // Render life icons as small rectangles
     for (int i = 0; i < lives; ++i) {
         int iconX = x + i * (LIFE_ICON_SIZE + 2);
-        std::cout << "  Rendering life icon " << i << " at (" << iconX << "," << y << ")" << std::endl;
-        renderer.fillRect(iconX, y, LIFE_ICON_SIZE, LIFE_ICON_SIZE, BattleCityPalette::COLOR_RED);
+        renderer.queueRect(RenderLayer::HUD, iconX, y, LIFE_ICON_SIZE, LIFE_ICON_SIZE, BattleCityPalette::COLOR_RED);
     }
 }
 
 void HUD::renderScore(Renderer& renderer, int score, int x, int y) {
-    std::string scoreStr = formatScore(score);
-    std::cout << "HUD::renderScore rendering score '" << scoreStr << "' at (" << x << "," << y << ")" << std::endl;
-    renderer.drawText(x, y, scoreStr.c_str());
+    if (score != cachedScore_) {
+        scoreText_ = formatScore(score);
+        cachedScore_ = score;
+    }
+    renderer.queueText(RenderLayer::HUD, x, y, scoreText_.c_str());
 }
 
 void HUD::renderLevel(Renderer& renderer, int level, int x, int y) {
-    std::string levelStr = "STAGE " + formatLevel(level);
-    std::cout << "HUD::renderLevel rendering level '" << levelStr << "' at (" << x << "," << y << ")" << std::endl;
-    renderer.drawText(x, y, levelStr.c_str());
+    if (level != cachedLevel_) {
+        levelText_ = "STAGE " + formatLevel(level);
+        cachedLevel_ = level;
+    }
+    renderer.queueText(RenderLayer::HUD, x, y, levelText_.c_str());
 }
 
 void HUD::renderPowerUpIcon(PowerUpType type, int x, int y) {
@@ -26,7 +26,15 @@ private:
     static constexpr int LEVEL_TEXT_X = 180;
     static constexpr int LEVEL_TEXT_Y = 8;
 
+    // Formatted text is kept between frames and only rebuilt when the value changes
+    int cachedScore_;
+    int cachedLevel_;
+    std::string scoreText_;
+    std::string levelText_;
+
 public:
+    HUD();
+
     void render(Renderer& renderer, int score, int lives, int level, bool isTwoPlayerMode = false);
 
 private:
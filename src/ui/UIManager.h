@@ -18,14 +18,14 @@ public:
         sprintf(levelText, "STAGE %02d", level);
 
         // Render HUD elements
-        renderer.drawText(8, 8, "SCORE:", BattleCityPalette::COLOR_WHITE);
-        renderer.drawText(8, 20, scoreText, BattleCityPalette::COLOR_WHITE);
-        renderer.drawText(200, 8, levelText, BattleCityPalette::COLOR_WHITE);
+        renderer.queueText(RenderLayer::HUD, 8, 8, "SCORE:", BattleCityPalette::COLOR_WHITE);
+        renderer.queueText(RenderLayer::HUD, 8, 20, scoreText, BattleCityPalette::COLOR_WHITE);
+        renderer.queueText(RenderLayer::HUD, 200, 8, levelText, BattleCityPalette::COLOR_WHITE);
 
         // Render lives as tank icons
         for (int i = 0; i < lives; ++i) {
             // Simple rectangle representation for now
-            renderer.fillRect(8 + i * 12, 8, 8, 8, BattleCityPalette::COLOR_RED);
+            renderer.queueRect(RenderLayer::HUD, 8 + i * 12, 8, 8, 8, BattleCityPalette::COLOR_RED);
         }
     }
 };
@@ -0,0 +1,146 @@
+#include "AssetPack.h"
+#include "FileUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BattleCity {
+
+AssetPack::AssetPack()
+    : data_(nullptr), size_(0)
+#ifdef _WIN32
+    , fileHandle_(nullptr), mappingHandle_(nullptr)
+#else
+    , mapped_(false)
+#endif
+{
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view) {
+            fileHandle_ = file;
+            mappingHandle_ = mapping;
+            data_ = static_cast<const uint8_t*>(view);
+            size_ = static_cast<size_t>(fileSize.QuadPart);
+        } else {
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+        }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                data_ = static_cast<const uint8_t*>(view);
+                size_ = static_cast<size_t>(info.st_size);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);  // The mapping keeps its own reference
+    }
+#endif
+
+    // No mapping available: read the file into memory instead
+    if (!data_) {
+        buffer_ = FileUtils::readBinaryFile(path);
+        if (buffer_.empty()) return false;
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    if (!validate()) {
+        std::cerr << "AssetPack: " << path << " is not a valid version " << PACK_VERSION
+                  << " pack" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+#ifdef _WIN32
+    if (mappingHandle_) {
+        UnmapViewOfFile(data_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+    }
+#else
+    if (mapped_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        mapped_ = false;
+    }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+}
+
+uint32_t AssetPack::getEntryCount() const {
+    return data_ ? reinterpret_cast<const PackHeader*>(data_)->entryCount : 0;
+}
+
+const PackEntry& AssetPack::getEntry(uint32_t index) const {
+    return reinterpret_cast<const PackEntry*>(data_ + sizeof(PackHeader))[index];
+}
+
+const PackEntry* AssetPack::find(std::string_view name) const {
+    if (!data_) return nullptr;
+
+    // The baker writes the table sorted by name
+    const PackEntry* begin = &getEntry(0);
+    const PackEntry* end = begin + getEntryCount();
+    const PackEntry* it = std::lower_bound(begin, end, name,
+        [](const PackEntry& entry, std::string_view key) { return std::string_view(entry.name) < key; });
+    return (it != end && std::string_view(it->name) == name) ? it : nullptr;
+}
+
+bool AssetPack::validate() const {
+    if (size_ < sizeof(PackHeader)) return false;
+
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(data_);
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION) return false;
+    if (sizeof(PackHeader) + static_cast<size_t>(header->entryCount) * sizeof(PackEntry) > size_) return false;
+
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const PackEntry& entry = getEntry(i);
+        if (std::memchr(entry.name, '\0', sizeof(entry.name)) == nullptr) return false;
+        if (static_cast<size_t>(entry.offset) + entry.size > size_) return false;
+        if (entry.offset % PACK_ALIGNMENT != 0) return false;
+    }
+    return true;
+}
+
+} // namespace BattleCity
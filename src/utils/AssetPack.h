@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BattleCity {
+
+// Baked asset pack (written by tools/asset_baker, read by AssetPack).
+//
+// Layout: PackHeader, then entryCount PackEntry records sorted by name, then
+// the entry payloads, each starting on a PACK_ALIGNMENT boundary. All fields
+// are little-endian and laid out so the mapped file can be used in place.
+constexpr uint32_t PACK_MAGIC = 0x4B504342;  // "BCPK"
+constexpr uint32_t PACK_VERSION = 1;
+constexpr uint32_t PACK_ALIGNMENT = 16;
+constexpr const char* PACK_FILE_NAME = "assets.pack";
+
+enum class PackEntryType : uint32_t {
+    BLOB,           // Raw file bytes
+    INDEXED_IMAGE,  // width * height palette indices
+    SPRITE_TABLE    // PackSprite records
+};
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[48];       // Null-terminated, e.g. "atlas/pixels"
+    PackEntryType type;
+    uint32_t offset;     // From the start of the file
+    uint32_t size;       // Payload size in bytes
+    uint16_t width;      // Image entries only
+    uint16_t height;
+};
+
+// Atlas sprite record: name (empty for generated rotations) and atlas rect
+struct PackSprite {
+    char name[48];
+    int32_t x, y, w, h;
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 64, "PackEntry layout");
+static_assert(sizeof(PackSprite) == 64, "PackSprite layout");
+
+// Read-only memory mapping of an asset pack. Entry payloads point straight
+// into the mapping and stay valid until the pack is closed.
+class AssetPack {
+private:
+    const uint8_t* data_;
+    size_t size_;
+    std::vector<uint8_t> buffer_;  // Used when the file cannot be mapped
+
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mappingHandle_;
+#else
+    bool mapped_;
+#endif
+
+public:
+    AssetPack();
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Table of contents
+    uint32_t getEntryCount() const;
+    const PackEntry& getEntry(uint32_t index) const;
+    const PackEntry* find(std::string_view name) const;
+
+    // Payload of an entry
+    const uint8_t* getData(const PackEntry& entry) const { return data_ + entry.offset; }
+
+private:
+    bool validate() const;
+};
+
+} // namespace BattleCity
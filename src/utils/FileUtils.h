@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -7,10 +10,37 @@ namespace BattleCity {
 
 class FileUtils {
 public:
-    static std::string readTextFile(const std::string& path) { return ""; }
-    static bool writeTextFile(const std::string& path, const std::string& content) { return true; }
-    static std::vector<uint8_t> readBinaryFile(const std::string& path) { return {}; }
-    static bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data) { return true; }
+    static std::string readTextFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return "";
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    static bool writeTextFile(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return static_cast<bool>(file);
+    }
+
+    static std::vector<uint8_t> readBinaryFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return {};
+        std::streamsize size = file.tellg();
+        if (size <= 0) return {};
+        std::vector<uint8_t> data(static_cast<size_t>(size));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), size);
+        if (!file) return {};
+        return data;
+    }
+
+    static bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    }
 };
 
-} // namespace BattleCity
\ No newline at end of file
+} // namespace BattleCity
@@ -114,15 +114,18 @@ enum class EnemyType {
     ELITE
 };
 
-// Terrain types
-enum class TerrainType {
+// Terrain types (one byte per tile; values match the stage file digits)
+enum class TerrainType : uint8_t {
     GRASS,
     BRICK,
     STEEL,
     WATER,
-    BASE_BRICK
+    BASE_BRICK,
+    FOREST      // Passable, drawn over tanks
 };
 
+constexpr int TERRAIN_TYPE_COUNT = 6;
+
 
 // Utility functions
 class MathUtils {
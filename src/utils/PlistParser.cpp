@@ -0,0 +1,214 @@
+#include "PlistParser.h"
+
+namespace BattleCity {
+
+namespace {
+
+struct Cursor {
+    std::string_view text;
+    size_t pos;
+};
+
+struct Element {
+    std::string_view name;  // Tag name without brackets or slashes
+    bool closing;           // </name>
+    bool empty;             // <name/>
+};
+
+// Advance to the next element, skipping the declaration, doctype and comments
+bool nextElement(Cursor& cursor, Element& element) {
+    while (true) {
+        size_t open = cursor.text.find('<', cursor.pos);
+        if (open == std::string_view::npos) return false;
+
+        if (cursor.text.compare(open, 4, "<!--") == 0) {
+            size_t end = cursor.text.find("-->", open + 4);
+            if (end == std::string_view::npos) return false;
+            cursor.pos = end + 3;
+            continue;
+        }
+
+        size_t close = cursor.text.find('>', open);
+        if (close == std::string_view::npos) return false;
+        cursor.pos = close + 1;
+
+        std::string_view tag = cursor.text.substr(open + 1, close - open - 1);
+        if (tag.empty() || tag[0] == '?' || tag[0] == '!') continue;
+
+        element.closing = tag[0] == '/';
+        if (element.closing) tag.remove_prefix(1);
+        element.empty = !tag.empty() && tag.back() == '/';
+        if (element.empty) tag.remove_suffix(1);
+        element.name = tag.substr(0, tag.find_first_of(" \t\r\n"));
+        return true;
+    }
+}
+
+// Text up to the next element (entities are not decoded)
+std::string_view readText(Cursor& cursor) {
+    size_t end = cursor.text.find('<', cursor.pos);
+    if (end == std::string_view::npos) end = cursor.text.size();
+    std::string_view text = cursor.text.substr(cursor.pos, end - cursor.pos);
+    cursor.pos = end;
+    return text;
+}
+
+// Skip the rest of a <dict> or <array> whose opening tag was already read
+bool skipContainer(Cursor& cursor) {
+    Element element;
+    int depth = 1;
+    while (depth > 0) {
+        if (!nextElement(cursor, element)) return false;
+        if (element.empty) continue;
+        if (element.name == "dict" || element.name == "array") {
+            depth += element.closing ? -1 : 1;
+        }
+    }
+    return true;
+}
+
+// Read a scalar value (<string>, <integer>, <true/> ...). Containers are skipped
+// and yield empty text.
+bool readValue(Cursor& cursor, std::string_view& type, std::string_view& text) {
+    Element element;
+    if (!nextElement(cursor, element) || element.closing) return false;
+
+    type = element.name;
+    text = std::string_view();
+    if (element.empty) return true;
+    if (element.name == "dict" || element.name == "array") return skipContainer(cursor);
+
+    text = readText(cursor);
+    return nextElement(cursor, element) && element.closing;
+}
+
+// Next <key> of the current dict; false at its closing </dict>
+bool readKey(Cursor& cursor, std::string_view& key) {
+    Element element;
+    if (!nextElement(cursor, element) || element.closing || element.name != "key") return false;
+    if (element.empty) {
+        key = std::string_view();
+        return true;
+    }
+    key = readText(cursor);
+    return nextElement(cursor, element) && element.closing;
+}
+
+bool openDict(Cursor& cursor) {
+    Element element;
+    return nextElement(cursor, element) && !element.closing && !element.empty && element.name == "dict";
+}
+
+bool parseFrame(Cursor& cursor, PlistFrame& frame) {
+    if (!openDict(cursor)) return false;
+
+    std::string_view key, type, text;
+    while (readKey(cursor, key)) {
+        if (!readValue(cursor, type, text)) return false;
+
+        // Format 3 key names first, format 2 names second
+        int values[4];
+        if (key == "textureRect" || key == "frame") {
+            if (PlistParser::parseIntegers(text, values, 4) == 4) {
+                frame.textureRect = Rect(values[0], values[1], values[2], values[3]);
+            }
+        } else if (key == "spriteOffset" || key == "offset") {
+            if (PlistParser::parseIntegers(text, values, 2) == 2) {
+                frame.offsetX = values[0];
+                frame.offsetY = values[1];
+            }
+        } else if (key == "spriteSourceSize" || key == "sourceSize") {
+            if (PlistParser::parseIntegers(text, values, 2) == 2) {
+                frame.sourceWidth = values[0];
+                frame.sourceHeight = values[1];
+            }
+        } else if (key == "textureRotated" || key == "rotated") {
+            frame.rotated = type == "true";
+        }
+    }
+
+    // Untrimmed frames may omit the source size
+    if (frame.sourceWidth <= 0) frame.sourceWidth = frame.textureRect.w;
+    if (frame.sourceHeight <= 0) frame.sourceHeight = frame.textureRect.h;
+    return true;
+}
+
+bool parseMetadata(Cursor& cursor, PlistFrameTable& table) {
+    if (!openDict(cursor)) return false;
+
+    std::string_view key, type, text;
+    while (readKey(cursor, key)) {
+        if (!readValue(cursor, type, text)) return false;
+
+        if (key == "realTextureFileName" || (key == "textureFileName" && table.textureFileName.empty())) {
+            table.textureFileName.assign(text.data(), text.size());
+        } else if (key == "size") {
+            int values[2];
+            if (PlistParser::parseIntegers(text, values, 2) == 2) {
+                table.textureWidth = values[0];
+                table.textureHeight = values[1];
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool PlistParser::parseFrameTable(std::string_view text, PlistFrameTable& table) {
+    table = PlistFrameTable();
+
+    // Root dictionary inside <plist>
+    Cursor cursor{text, 0};
+    Element element;
+    do {
+        if (!nextElement(cursor, element)) return false;
+    } while (element.closing || element.empty || element.name != "dict");
+
+    std::string_view key, type, value;
+    while (readKey(cursor, key)) {
+        if (key == "frames") {
+            if (!openDict(cursor)) return false;
+
+            std::string_view frameName;
+            while (readKey(cursor, frameName)) {
+                PlistFrame frame;
+                frame.name.assign(frameName.data(), frameName.size());
+                if (!parseFrame(cursor, frame)) return false;
+                table.frames.push_back(std::move(frame));
+            }
+        } else if (key == "metadata") {
+            if (!parseMetadata(cursor, table)) return false;
+        } else if (!readValue(cursor, type, value)) {
+            return false;
+        }
+    }
+
+    return !table.frames.empty();
+}
+
+int PlistParser::parseIntegers(std::string_view text, int* values, int count) {
+    int found = 0;
+    size_t i = 0;
+    while (i < text.size() && found < count) {
+        bool negative = text[i] == '-';
+        size_t start = negative ? i + 1 : i;
+        if (start >= text.size() || text[start] < '0' || text[start] > '9') {
+            ++i;
+            continue;
+        }
+
+        int value = 0;
+        for (i = start; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            value = value * 10 + (text[i] - '0');
+        }
+        // Drop any fractional part
+        if (i < text.size() && text[i] == '.') {
+            for (++i; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {}
+        }
+        values[found++] = negative ? -value : value;
+    }
+    return found;
+}
+
+} // namespace BattleCity
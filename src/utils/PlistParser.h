@@ -0,0 +1,41 @@
+#pragma once
+
+#include "MathUtils.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BattleCity {
+
+// One frame of a TexturePacker sheet
+struct PlistFrame {
+    std::string name;       // Frame key, e.g. "p1_0_0.png"
+    Rect textureRect;       // Region in the sheet (unrotated size)
+    int offsetX, offsetY;   // Trim offset from the source center (y up)
+    int sourceWidth;        // Untrimmed sprite size
+    int sourceHeight;
+    bool rotated;           // Stored rotated 90 degrees clockwise in the sheet
+
+    PlistFrame() : offsetX(0), offsetY(0), sourceWidth(0), sourceHeight(0), rotated(false) {}
+};
+
+struct PlistFrameTable {
+    std::vector<PlistFrame> frames;
+    std::string textureFileName;
+    int textureWidth = 0;
+    int textureHeight = 0;
+};
+
+// Minimal reader for TexturePacker / cocos2d .plist frame tables (format 2
+// and 3). Scans the XML in place without building a document tree; only the
+// frame names and texture file name are copied out.
+class PlistParser {
+public:
+    static bool parseFrameTable(std::string_view text, PlistFrameTable& table);
+
+    // Read up to count integers from strings like "{{0,88},{14,15}}".
+    // Fractional parts are truncated. Returns the number of values read.
+    static int parseIntegers(std::string_view text, int* values, int count);
+};
+
+} // namespace BattleCity
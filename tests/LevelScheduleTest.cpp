@@ -0,0 +1,59 @@
+// Spawn schedules of the stages as the game plays them from assets/levels
+// (run from the source directory)
+#include "level/LevelLoader.h"
+#include "level/SpawnSchedule.h"
+#include "utils/FileUtils.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace BattleCity;
+
+namespace {
+
+const char* LEVEL_DIRECTORY = "assets/levels";
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Same rule as LevelManager::buildLevelData
+bool buildStageSchedule(int level, SpawnSchedule& schedule) {
+    int fileCount = LevelLoader::countStageFiles(LEVEL_DIRECTORY, LevelManager::MAX_LEVELS);
+    int file = LevelLoader::getStageFile(level, fileCount);
+    if (file == 0) return false;
+
+    LevelData data = {};
+    std::string error;
+    if (!LevelLoader::parse(FileUtils::readTextFile(LevelLoader::levelPath(LEVEL_DIRECTORY, file)), data, error)) {
+        std::cerr << "stage file " << file << ": " << error << std::endl;
+        return false;
+    }
+    if (LevelLoader::isReplayedStage(level, fileCount)) data.enemyPattern.clear();
+    schedule = buildSpawnSchedule(level, data.enemyPattern, DEFAULT_ENEMY_SPAWN_POINTS);
+    return true;
+}
+
+bool hasEnemy(const SpawnSchedule& schedule, EnemyType type) {
+    return std::any_of(schedule.begin(), schedule.end(), [type](const SpawnEntry& entry) { return entry.type == type; });
+}
+
+} // namespace
+
+int main() {
+    SpawnSchedule schedule;
+    check(buildStageSchedule(20, schedule), "stage 20 loads");
+    check(hasEnemy(schedule, EnemyType::HEAVY), "stage 20 spawns HEAVY tanks");
+    check(hasEnemy(schedule, EnemyType::ELITE), "stage 20 spawns ELITE tanks");
+
+    // A stage with its own file keeps the file's spawn list
+    check(buildStageSchedule(1, schedule), "stage 1 loads");
+    check(!hasEnemy(schedule, EnemyType::HEAVY) && !hasEnemy(schedule, EnemyType::ELITE),
+          "stage 1 follows its file (BASIC and FAST only)");
+
+    if (failures == 0) std::cout << "LevelScheduleTest: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
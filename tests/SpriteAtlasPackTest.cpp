@@ -0,0 +1,82 @@
+// SpriteAtlas::loadPack must reject sprite records it can't draw safely
+#include "graphics/SpriteAtlas.h"
+#include "utils/AssetPack.h"
+#include "utils/FileUtils.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace BattleCity;
+
+namespace {
+
+constexpr int ATLAS_SIZE = 16;
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// A pack with a 16x16 atlas and one sprite at rect
+std::vector<uint8_t> buildPack(int x, int y, int w, int h) {
+    const uint32_t pixelsOffset = PACK_ALIGNMENT * 9;  // Past the header and two entries
+    const uint32_t pixelsSize = ATLAS_SIZE * ATLAS_SIZE;
+    const uint32_t spritesOffset = pixelsOffset + pixelsSize;
+
+    std::vector<uint8_t> pack(spritesOffset + sizeof(PackSprite), 0);
+    PackHeader header = {PACK_MAGIC, PACK_VERSION, 2, 0};
+    std::memcpy(pack.data(), &header, sizeof(header));
+
+    PackEntry entries[2] = {};
+    std::strcpy(entries[0].name, "atlas/pixels");
+    entries[0].type = PackEntryType::INDEXED_IMAGE;
+    entries[0].offset = pixelsOffset;
+    entries[0].size = pixelsSize;
+    entries[0].width = ATLAS_SIZE;
+    entries[0].height = ATLAS_SIZE;
+    std::strcpy(entries[1].name, "atlas/sprites");
+    entries[1].type = PackEntryType::SPRITE_TABLE;
+    entries[1].offset = spritesOffset;
+    entries[1].size = sizeof(PackSprite);
+    std::memcpy(pack.data() + sizeof(header), entries, sizeof(entries));
+
+    std::memset(pack.data() + pixelsOffset, 1, pixelsSize);
+    PackSprite sprite = {};
+    std::strcpy(sprite.name, "test/sprite");
+    sprite.x = x;
+    sprite.y = y;
+    sprite.w = w;
+    sprite.h = h;
+    std::memcpy(pack.data() + spritesOffset, &sprite, sizeof(sprite));
+    return pack;
+}
+
+bool loads(const std::vector<uint8_t>& bytes) {
+    std::string path = (std::filesystem::temp_directory_path() / "battlecity_atlas_test.pack").string();
+    if (!FileUtils::writeBinaryFile(path, bytes)) return false;
+
+    AssetPack pack;
+    SpriteAtlas atlas;
+    bool loaded = pack.open(path) && atlas.loadPack(pack);
+    pack.close();
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return loaded;
+}
+
+} // namespace
+
+int main() {
+    check(loads(buildPack(0, 0, 8, 8)), "a valid pack loads");
+    check(!loads(buildPack(0, 0, 0, 8)), "a zero-width sprite is rejected");
+    check(!loads(buildPack(0, 0, 8, 0)), "a zero-height sprite is rejected");
+    check(!loads(buildPack(12, 0, 8, 8)), "a sprite past the atlas edge is rejected");
+
+    if (failures == 0) std::cout << "SpriteAtlasPackTest: all checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// Offline asset baker: converts the sprites in assets/ into a single pack
+// file that the game maps at startup (see src/utils/AssetPack.h for the
+// format), and the stage files into the level pack (see src/level/LevelPack.h).
+//
+// Usage: BattleCityBaker [assets directory] [output pack]
+//        BattleCityBaker --schedules [assets directory]
+//
+// --schedules prints every stage's enemy spawn schedule instead of baking,
+// so schedule changes can be reviewed as a text diff.
+
+#define SDL_MAIN_HANDLED
+#include "graphics/Palette.h"
+#include "graphics/SpriteAtlas.h"
+#include "level/LevelPack.h"
+#include "level/SpawnSchedule.h"
+#include "utils/AssetPack.h"
+#include "utils/FileUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace BattleCity;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct BakedEntry {
+    std::string name;
+    PackEntryType type;
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint8_t> data;
+};
+
+uint32_t alignUp(size_t value) {
+    return static_cast<uint32_t>((value + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT);
+}
+
+bool bakeAtlas(const fs::path& spriteRoot, std::vector<BakedEntry>& entries) {
+    Palette palette;
+    SpriteAtlas atlas;
+    if (!atlas.load(spriteRoot.string(), palette)) {
+        std::cerr << "No sprites found in " << spriteRoot.string() << std::endl;
+        return false;
+    }
+
+    const IndexedSurface& surface = atlas.getSurface();
+    if (surface.getWidth() > 0xFFFF || surface.getHeight() > 0xFFFF) {
+        std::cerr << "Atlas too large" << std::endl;
+        return false;
+    }
+
+    BakedEntry pixels{"atlas/pixels", PackEntryType::INDEXED_IMAGE,
+                      static_cast<uint16_t>(surface.getWidth()), static_cast<uint16_t>(surface.getHeight()), {}};
+    pixels.data.assign(surface.getPixels(),
+                       surface.getPixels() + static_cast<size_t>(surface.getWidth()) * surface.getHeight());
+    entries.push_back(std::move(pixels));
+
+    std::vector<std::string> names = atlas.getSpriteNames();
+    BakedEntry sprites{"atlas/sprites", PackEntryType::SPRITE_TABLE, 0, 0, {}};
+    sprites.data.resize(names.size() * sizeof(PackSprite));
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i].size() >= sizeof(PackSprite::name)) {
+            std::cerr << "Sprite name too long: " << names[i] << std::endl;
+            return false;
+        }
+        PackSprite record = {};
+        std::memcpy(record.name, names[i].data(), names[i].size());
+        const Rect& rect = atlas.getRect(static_cast<SpriteId>(i));
+        record.x = rect.x;
+        record.y = rect.y;
+        record.w = rect.w;
+        record.h = rect.h;
+        std::memcpy(sprites.data.data() + i * sizeof(PackSprite), &record, sizeof(PackSprite));
+    }
+    entries.push_back(std::move(sprites));
+
+    std::cout << "atlas: " << names.size() << " sprites, " << surface.getWidth() << "x"
+              << surface.getHeight() << std::endl;
+    return true;
+}
+
+// Parse levelNN.txt from 01 up to the first missing stage into one level pack
+bool bakeLevelPack(const fs::path& directory, const fs::path& output) {
+    std::vector<LevelData> stages;
+    for (int stage = 1;; ++stage) {
+        std::string path = LevelLoader::levelPath(directory.string(), stage);
+        std::error_code error;
+        if (!fs::exists(path, error)) break;
+
+        LevelData level = {};
+        std::string message;
+        if (!LevelLoader::parse(FileUtils::readTextFile(path), level, message)) {
+            std::cerr << path << ": " << message << std::endl;
+            return false;
+        }
+        if (!LevelLoader::isStandardSize(level)) {
+            // The pack only holds 13x13 stages; the game reads this one from its file
+            std::cout << path << ": custom arena size, left out of " << output.string() << std::endl;
+        }
+        stages.push_back(std::move(level));
+    }
+    if (stages.empty()) return true;  // Nothing to bake, the game reads the stage files
+
+    std::vector<uint8_t> pack = LevelPack::build(stages);
+    if (!FileUtils::writeBinaryFile(output.string(), pack)) {
+        std::cerr << "Failed to write " << output.string() << std::endl;
+        return false;
+    }
+    std::cout << output.string() << ": " << stages.size() << " stages, " << pack.size() << " bytes" << std::endl;
+    return true;
+}
+
+// Every stage the game plays, with the stage files resolved the way
+// LevelManager does, so the schedules match what is played
+void printSpawnSchedules(const fs::path& directory) {
+    int fileCount = LevelLoader::countStageFiles(directory.string(), LevelManager::MAX_LEVELS);
+    for (int stage = 1; stage <= LevelManager::MAX_LEVELS; ++stage) {
+        LevelData level = {};
+        int file = LevelLoader::getStageFile(stage, fileCount);
+        if (file != 0) {
+            std::string path = LevelLoader::levelPath(directory.string(), file);
+            std::string message;
+            if (!LevelLoader::parse(FileUtils::readTextFile(path), level, message)) {
+                std::cerr << path << ": " << message << std::endl;
+                continue;
+            }
+            if (LevelLoader::isReplayedStage(stage, fileCount)) level.enemyPattern.clear();
+        }
+        int spawnPoints = level.enemySpawnPoints.empty() ? DEFAULT_ENEMY_SPAWN_POINTS
+                                                         : static_cast<int>(level.enemySpawnPoints.size());
+        SpawnSchedule schedule = buildSpawnSchedule(stage, level.enemyPattern, spawnPoints);
+        std::cout << "stage " << stage << "\n" << describeSpawnSchedule(schedule);
+    }
+}
+
+bool writePack(const std::string& path, std::vector<BakedEntry>& entries) {
+    // Sorted table so the reader can binary search it
+    std::sort(entries.begin(), entries.end(),
+              [](const BakedEntry& a, const BakedEntry& b) { return a.name < b.name; });
+
+    PackHeader header = {PACK_MAGIC, PACK_VERSION, static_cast<uint32_t>(entries.size()), 0};
+    size_t offset = alignUp(sizeof(PackHeader) + entries.size() * sizeof(PackEntry));
+
+    std::vector<PackEntry> table(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        PackEntry& record = table[i];
+        record = {};
+        std::memcpy(record.name, entries[i].name.data(), entries[i].name.size());
+        record.type = entries[i].type;
+        record.offset = static_cast<uint32_t>(offset);
+        record.size = static_cast<uint32_t>(entries[i].data.size());
+        record.width = entries[i].width;
+        record.height = entries[i].height;
+        offset = alignUp(offset + entries[i].data.size());
+    }
+
+    std::vector<uint8_t> pack(offset, 0);
+    std::memcpy(pack.data(), &header, sizeof(header));
+    std::memcpy(pack.data() + sizeof(header), table.data(), table.size() * sizeof(PackEntry));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        std::copy(entries[i].data.begin(), entries[i].data.end(), pack.begin() + table[i].offset);
+    }
+
+    if (!FileUtils::writeBinaryFile(path, pack)) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+    std::cout << path << ": " << entries.size() << " entries, " << pack.size() << " bytes" << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--schedules") == 0) {
+        printSpawnSchedules(fs::path(argc > 2 ? argv[2] : "assets") / "levels");
+        return 0;
+    }
+
+    fs::path assetRoot = argc > 1 ? argv[1] : "assets";
+    std::string output = argc > 2 ? argv[2] : (assetRoot / PACK_FILE_NAME).string();
+
+    std::vector<BakedEntry> entries;
+    if (!bakeAtlas(assetRoot / "sprites", entries)) return 1;
+
+    if (!bakeLevelPack(assetRoot / "levels", assetRoot / LEVEL_PACK_FILE_NAME)) return 1;
+
+    return writePack(output, entries) ? 0 : 1;
+}